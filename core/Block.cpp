@@ -6,20 +6,25 @@
 #include "llvm/IR/InstrTypes.h"
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/GetElementPtrTypeIterator.h"
+#include "llvm/IR/IntrinsicInst.h"
 #include "llvm/ADT/APInt.h"
 
 #include "Func.h"
+#include "MemoryReport.h"
+#include "Trace.h"
 #include "../type/Type.h"
 #include "../expr/BinaryExpr.h"
 #include "../expr/UnaryExpr.h"
+#include "../expr/ExprVisitor.h"
 
 #include <utility>
+#include <algorithm>
 #include <cstdint>
 #include <string>
 #include <set>
 #include <iostream>
 #include <fstream>
-#include <regex>
+#include <cctype>
 
 using CaseHandle = const llvm::SwitchInst::CaseHandleImpl<const llvm::SwitchInst, const llvm::ConstantInt, const llvm::BasicBlock>*;
 
@@ -37,6 +42,14 @@ Block::Block(const std::string &blockName, const llvm::BasicBlock* block, Func*
       blockName(blockName) { }
 
 void Block::parseLLVMBlock() {
+    MemoryReport::Scope memoryScope(MemoryReport::BLOCK);
+
+    //only large blocks are traced, so the trace stays small
+    std::unique_ptr<Trace::Span> span;
+    if (Trace::enabled && block->size() >= Trace::blockThreshold) {
+        span = std::make_unique<Trace::Span>("parseLLVMBlock", func->function->getName().str() + ":" + blockName);
+    }
+
     //parse alloca and metadata first, so the types are set correctly
     for (const auto& ins : *block) {
         if (ins.getOpcode() == llvm::Instruction::Alloca) {
@@ -62,64 +75,90 @@ void Block::parseLLVMBlock() {
     }
 }
 
-void Block::output(std::ostream& stream) {
-    unsetAllInit();
-    for (const auto expr : expressions) {
-        if (auto V = dynamic_cast<Value*>(expr)) {
-            stream << "    ";
-            if (!V->init) {
-                stream << V->getType()->toString();
-                stream << " ";
-                stream << expr->toString();
-                stream << ";\n";
-                V->init = true;
+/**
+ * @brief The StatementOutput class outputs expressions of a block as C statements.
+ */
+class StatementOutput : public ExprVisitor<StatementOutput> {
+private:
+    std::ostream& stream;
+    bool noFuncCasts; //calls are output without casts of the called function
+
+    /**
+     * @brief getUncastedCall Returns called expression of function call stripped of all casts.
+     * @param CE Function call
+     * @return Called expression without casts, nullptr if the called expression is not cast
+     */
+    Expr* getUncastedCall(CallExpr* CE) const {
+        auto call = CE->funcValue;
+        bool hasCast = false;
+        while (auto CAST = llvm::dyn_cast_or_null<CastExpr>(call)) {
+            hasCast = true;
+            call = CAST->expr;
+        }
+
+        return hasCast ? call : nullptr;
+    }
+
+public:
+    StatementOutput(std::ostream& stream, bool noFuncCasts)
+        : stream(stream),
+          noFuncCasts(noFuncCasts) { }
+
+    void visitExpr(Expr* expr) {
+        stream << "    ";
+        stream << expr->toString();
+        stream << "\n";
+    }
+
+    void visitValue(Value* V) {
+        stream << "    ";
+        if (!V->init) {
+            stream << V->getType()->toString();
+            stream << " ";
+            stream << V->toString();
+            stream << V->alignToString();
+            stream << ";\n";
+            V->init = true;
+        }
+    }
+
+    void visitCallExpr(CallExpr* CE) {
+        if (noFuncCasts) {
+            if (auto call = getUncastedCall(CE)) {
+                stream << "    ";
+                stream << call->toString().substr(1, call->toString().size() - 1);
+                stream << "(" << CE->paramsToString() << ");\n";
+                return;
             }
-            continue;
         }
 
-        if (auto CE = dynamic_cast<CallExpr*>(expr)) {
-            if (func->program->noFuncCasts) {
-                auto call = CE->funcValue;
-                bool hasCast = false;
-                while (auto CAST = dynamic_cast<CastExpr*>(call)) {
-                    hasCast = true;
-                    call = CAST->expr;
-                }
+        visitExpr(CE);
+    }
 
-                if (hasCast) {
-                    stream << "    ";
+    void visitAssignExpr(AssignExpr* EE) {
+        if (noFuncCasts) {
+            if (auto CE = llvm::dyn_cast_or_null<CallExpr>(EE->right)) {
+                if (auto call = getUncastedCall(CE)) {
+                    stream << "    (";
+                    stream << EE->left->toString();
+                    stream << ") = ";
                     stream << call->toString().substr(1, call->toString().size() - 1);
                     stream << "(" << CE->paramsToString() << ");\n";
-                    continue;
+                    return;
                 }
             }
         }
 
-        if (auto EE = dynamic_cast<AssignExpr*>(expr)) {
-            if (func->program->noFuncCasts) {
-                if (auto CE = dynamic_cast<CallExpr*>(EE->right)) {
-                    auto call = CE->funcValue;
-                    bool hasCast = false;
-                    while (auto CAST = dynamic_cast<CastExpr*>(call)) {
-                        hasCast = true;
-                        call = CAST->expr;
-                    }
-
-                    if (hasCast) {
-                        stream << "    (";
-                        stream << EE->left->toString();
-                        stream << ") = ";
-                        stream << call->toString().substr(1, call->toString().size() - 1);
-                        stream << "(" << CE->paramsToString() << ");\n";
-                        continue;
-                    }
-                }
-            }
-        }
+        visitExpr(EE);
+    }
+};
 
-        stream << "    ";
-        stream << expr->toString();
-        stream << "\n";
+void Block::output(std::ostream& stream) {
+    unsetAllInit();
+
+    StatementOutput statementOutput(stream, func->program->noFuncCasts);
+    for (const auto expr : expressions) {
+        statementOutput.visit(expr);
     }
 }
 
@@ -129,18 +168,24 @@ void Block::parseAllocaInstruction(const llvm::Instruction& ins, bool isConstExp
 
     valueMap[value] = std::make_unique<Value>(func->getVarName(), func->getType(allocaInst->getAllocatedType()));
 
+    //keep alignment of over-aligned variables (e.g. SIMD buffers)
+    if (allocaInst->getAllocatedType()->isSized() && allocaInst->getAlignment() > func->getDataLayout().getABITypeAlignment(allocaInst->getAllocatedType())) {
+        valueMap[value]->align = allocaInst->getAlignment();
+    }
+
     if (!isConstExpr) {
         addExpr(valueMap[value].get());
     }
 }
 
 void Block::parseLoadInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val) {
-    if (!func->getExpr(ins.getOperand(0))) {
-        createConstantValue(ins.getOperand(0));
+    Expr* pointer = func->getExpr(ins.getOperand(0));
+    if (const llvm::LoadInst* LI = llvm::dyn_cast<llvm::LoadInst>(&ins)) {
+        pointer = createAlignedPointer(pointer, LI->getPointerOperand(), LI->getAlignment());
     }
 
     //create new variable for every load instruction
-    loadDerefs.push_back(std::make_unique<DerefExpr>(func->getExpr(ins.getOperand(0))));
+    loadDerefs.push_back(std::make_unique<DerefExpr>(pointer));
     func->createExpr(isConstExpr ? val : &ins, std::make_unique<Value>(func->getVarName(), loadDerefs[loadDerefs.size() - 1]->getType()->clone()));
     stores.push_back(std::make_unique<AssignExpr>(func->getExpr(isConstExpr ? val : &ins), loadDerefs[loadDerefs.size() - 1].get()));
 
@@ -150,7 +195,7 @@ void Block::parseLoadInstruction(const llvm::Instruction& ins, bool isConstExpr,
 
 void Block::parseStoreInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val) {
     auto type = func->getType(ins.getOperand(0)->getType());
-    if (dynamic_cast<PointerType*>(type.get())) {
+    if (llvm::isa<PointerType>(type.get())) {
         if (llvm::Function* function = llvm::dyn_cast<llvm::Function>(ins.getOperand(0))) {
             if (!func->getExpr(ins.getOperand(0))) {
                 func->createExpr(ins.getOperand(0), std::make_unique<Value>("&" + function->getName().str(), std::make_unique<VoidType>()));
@@ -178,30 +223,24 @@ void Block::parseStoreInstruction(const llvm::Instruction& ins, bool isConstExpr
     if (isCast) {
         //inline asm with multiple outputs with casts
         if (llvm::ExtractValueInst* EVI = llvm::dyn_cast<llvm::ExtractValueInst>(inst)) {
-            if (!func->getExpr(ins.getOperand(1))) {
-                createConstantValue(ins.getOperand(1));
-            }
             Expr* value = func->getExpr(ins.getOperand(1));
             Expr* asmExpr = func->getExpr(EVI->getOperand(0));
 
-            if (auto RE = dynamic_cast<RefExpr*>(value)) {
+            if (auto RE = llvm::dyn_cast_or_null<RefExpr>(value)) {
                 value = RE->expr;
             }
 
-            if (auto AE = dynamic_cast<AsmExpr*>(asmExpr)) {
+            if (auto AE = llvm::dyn_cast_or_null<AsmExpr>(asmExpr)) {
                 AE->addOutputExpr(value, EVI->getIndices()[0]);
                 return;
             }
         }
 
         //inline asm with single output with cast
-        if (AsmExpr* AE = dynamic_cast<AsmExpr*>(func->getExpr(inst))) {
-            if (!func->getExpr(ins.getOperand(1))) {
-                createConstantValue(ins.getOperand(1));
-            }
+        if (AsmExpr* AE = llvm::dyn_cast_or_null<AsmExpr>(func->getExpr(inst))) {
             Expr* value = func->getExpr(ins.getOperand(1));
 
-            if (auto RE = dynamic_cast<RefExpr*>(value)) {
+            if (auto RE = llvm::dyn_cast_or_null<RefExpr>(value)) {
                 value = RE->expr;
             }
 
@@ -212,30 +251,21 @@ void Block::parseStoreInstruction(const llvm::Instruction& ins, bool isConstExpr
 
     //inline asm with multiple outputs
     if (llvm::ExtractValueInst* EVI = llvm::dyn_cast<llvm::ExtractValueInst>(ins.getOperand(0))) {
-        if (!func->getExpr(ins.getOperand(1))) {
-            createConstantValue(ins.getOperand(1));
-        }
         Expr* value = func->getExpr(ins.getOperand(1));
         Expr* asmExpr = func->getExpr(EVI->getOperand(0));
 
-        if (auto RE = dynamic_cast<RefExpr*>(value)) {
+        if (auto RE = llvm::dyn_cast_or_null<RefExpr>(value)) {
             value = RE->expr;
         }
 
-        if (auto AE = dynamic_cast<AsmExpr*>(asmExpr)) {
+        if (auto AE = llvm::dyn_cast_or_null<AsmExpr>(asmExpr)) {
             AE->addOutputExpr(value, EVI->getIndices()[0]);
             return;
         }
     }
 
-    if (!func->getExpr(ins.getOperand(0))) {
-        createConstantValue(ins.getOperand(0));
-    }
     Expr* val0 = func->getExpr(ins.getOperand(0));
 
-    if (!func->getExpr(ins.getOperand(1))) {
-        createConstantValue(ins.getOperand(1));
-    }
     Expr* val1 = func->getExpr(ins.getOperand(1));
 
     //storing to NULL
@@ -249,129 +279,45 @@ void Block::parseStoreInstruction(const llvm::Instruction& ins, bool isConstExpr
     }
 
     //inline asm with single output
-    if (auto AE = dynamic_cast<AsmExpr*>(val0)) {
-        if (auto RE = dynamic_cast<RefExpr*>(val1)) {
+    if (auto AE = llvm::dyn_cast_or_null<AsmExpr>(val0)) {
+        if (auto RE = llvm::dyn_cast_or_null<RefExpr>(val1)) {
             val1 = RE->expr;
         }
         AE->addOutputExpr(val1, 0);
         return;
     }
 
+    Expr* deref = derefs[val1].get();
+    const llvm::StoreInst* SI = llvm::cast<llvm::StoreInst>(&ins);
+    Expr* pointer = createAlignedPointer(val1, SI->getPointerOperand(), SI->getAlignment());
+    if (pointer != val1) {
+        loadDerefs.push_back(std::make_unique<DerefExpr>(pointer));
+        deref = loadDerefs[loadDerefs.size() - 1].get();
+    }
+
     if (!isConstExpr) {
-        func->createExpr(&ins, std::make_unique<AssignExpr>(derefs[val1].get(), val0));
+        func->createExpr(&ins, std::make_unique<AssignExpr>(deref, val0));
         addExpr(func->getExpr(&ins));
     } else {
-        func->createExpr(val, std::make_unique<AssignExpr>(derefs[val1].get(), val0));
+        func->createExpr(val, std::make_unique<AssignExpr>(deref, val0));
     }
 }
 
 void Block::parseBinaryInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val) {
-    if (!func->getExpr(ins.getOperand(0))) {
-        createConstantValue(ins.getOperand(0));
-    }
     Expr* val0 = func->getExpr(ins.getOperand(0));
-
-    if (!func->getExpr(ins.getOperand(1))) {
-        createConstantValue(ins.getOperand(1));
-    }
     Expr* val1 = func->getExpr(ins.getOperand(1));
 
     const llvm::Value* value = isConstExpr ? val : &ins;
-
-    switch (ins.getOpcode()) {
-    case llvm::Instruction::Add:
-    case llvm::Instruction::FAdd:
-        func->createExpr(value, std::make_unique<AddExpr>(val0, val1));
-        break;
-    case llvm::Instruction::Sub:
-    case llvm::Instruction::FSub:
-        func->createExpr(value, std::make_unique<SubExpr>(val0, val1));
-        break;
-    case llvm::Instruction::Mul:
-    case llvm::Instruction::FMul:
-        func->createExpr(value, std::make_unique<MulExpr>(val0, val1));
-        break;
-    case llvm::Instruction::SDiv:
-    case llvm::Instruction::UDiv:
-    case llvm::Instruction::FDiv:
-        func->createExpr(value, std::make_unique<DivExpr>(val0, val1));
-        break;
-    case llvm::Instruction::SRem:
-    case llvm::Instruction::URem:
-    case llvm::Instruction::FRem:
-        func->createExpr(value, std::make_unique<RemExpr>(val0, val1));
-        break;
-    case llvm::Instruction::And:
-        func->createExpr(value, std::make_unique<AndExpr>(val0, val1));
-        break;
-    case llvm::Instruction::Or:
-        func->createExpr(value, std::make_unique<OrExpr>(val0, val1));
-        break;
-    case llvm::Instruction::Xor:
-        func->createExpr(value, std::make_unique<XorExpr>(val0, val1));
-        break;
-    }
+    func->createExpr(value, createBinaryExpr(ins.getOpcode(), val0, val1));
 }
 
 void Block::parseCmpInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val) {
-    if (func->getExpr(ins.getOperand(0)) == nullptr) {
-        createConstantValue(ins.getOperand(0));
-    }
     Expr* val0 = func->getExpr(ins.getOperand(0));
-
-    if (func->getExpr(ins.getOperand(1)) == nullptr) {
-        createConstantValue(ins.getOperand(1));
-    }
     Expr* val1 = func->getExpr(ins.getOperand(1));
 
     auto cmpInst = llvm::cast<const llvm::CmpInst>(&ins);
     const llvm::Value* value = isConstExpr ? val : &ins;
-
-    switch(cmpInst->getPredicate()) {
-    case llvm::CmpInst::ICMP_EQ:
-    case llvm::CmpInst::FCMP_OEQ:
-    case llvm::CmpInst::FCMP_UEQ:
-        func->createExpr(value, std::make_unique<CmpExpr>(val0, val1, "==", false));
-        break;
-    case llvm::CmpInst::ICMP_NE:
-    case llvm::CmpInst::FCMP_ONE:
-    case llvm::CmpInst::FCMP_UNE:
-        func->createExpr(value, std::make_unique<CmpExpr>(val0, val1, "!=", false));
-        break;
-    case llvm::CmpInst::ICMP_UGT:
-    case llvm::CmpInst::ICMP_SGT:
-    case llvm::CmpInst::FCMP_UGT:
-    case llvm::CmpInst::FCMP_OGT:
-        func->createExpr(value, std::make_unique<CmpExpr>(val0, val1, ">", false));
-        break;
-    case llvm::CmpInst::ICMP_UGE:
-    case llvm::CmpInst::ICMP_SGE:
-    case llvm::CmpInst::FCMP_OGE:
-    case llvm::CmpInst::FCMP_UGE:
-        func->createExpr(value, std::make_unique<CmpExpr>(val0, val1, ">=", false));
-        break;
-    case llvm::CmpInst::ICMP_ULT:
-    case llvm::CmpInst::ICMP_SLT:
-    case llvm::CmpInst::FCMP_OLT:
-    case llvm::CmpInst::FCMP_ULT:
-        func->createExpr(value, std::make_unique<CmpExpr>(val0, val1, "<", false));
-        break;
-    case llvm::CmpInst::ICMP_ULE:
-    case llvm::CmpInst::ICMP_SLE:
-    case llvm::CmpInst::FCMP_OLE:
-    case llvm::CmpInst::FCMP_ULE:
-        func->createExpr(value, std::make_unique<CmpExpr>(val0, val1, "<=", false));
-        break;
-    case llvm::CmpInst::FCMP_FALSE:
-        func->createExpr(value, std::make_unique<Value>("0", std::make_unique<IntegerType>("int", false)));
-        break;
-    case llvm::CmpInst::FCMP_TRUE:
-        func->createExpr(value, std::make_unique<Value>("1", std::make_unique<IntegerType>("int", false)));
-        break;
-    default:
-        throw std::invalid_argument("FCMP ORD/UNO and BAD PREDICATE not supported!");
-
-    }
+    func->createExpr(value, createCmpExpr(cmpInst->getPredicate(), val0, val1));
 }
 
 void Block::parseBrInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val) {
@@ -403,41 +349,71 @@ void Block::parseBrInstruction(const llvm::Instruction& ins, bool isConstExpr, c
 void Block::parseRetInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val) {
     const llvm::Value* value = isConstExpr ? val : &ins;
 
+    const llvm::CallInst* tailCall = llvm::dyn_cast_or_null<llvm::CallInst>(ins.getPrevNode());
+    if (tailCall && !isReturnedTailCall(tailCall)) {
+        tailCall = nullptr;
+    }
+
     if (ins.getNumOperands() == 0) {
-        func->createExpr(value, std::make_unique<RetExpr>());
-    } else {
-        if (func->getExpr(ins.getOperand(0)) == nullptr) {
-            createConstantValue(ins.getOperand(0));
+        if (tailCall) {
+            func->createExpr(value, std::make_unique<RetExpr>(func->getExpr(tailCall)));
+        } else {
+            func->createExpr(value, std::make_unique<RetExpr>());
         }
+    } else {
         Expr* expr = func->getExpr(ins.getOperand(0));
 
         func->createExpr(value, std::make_unique<RetExpr>(expr));
     }
 
+    if (tailCall && tailCall->isMustTailCall()) {
+        static_cast<RetExpr*>(func->getExpr(value))->mustTail = true;
+    }
+
     addExpr(func->getExpr(&ins));
 }
 
 void Block::parseSwitchInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val) {
-    std::map<int, std::string> cases;
-
-    if (!func->getExpr(ins.getOperand(0))) {
-        createConstantValue(ins.getOperand(0));
-    }
     Expr* cmp = func->getExpr(ins.getOperand(0));
 
-    std::string def = func->getBlockName(llvm::cast<llvm::BasicBlock>(ins.getOperand(1)));
+    const llvm::BasicBlock* defBlock = llvm::cast<llvm::BasicBlock>(ins.getOperand(1));
+    std::string def = func->getBlockName(defBlock);
     const llvm::SwitchInst* switchIns = llvm::cast<const llvm::SwitchInst>(&ins);
 
+    //cases jumping to the default block are redundant
+    std::vector<std::pair<int64_t, const llvm::BasicBlock*>> values;
     for (const auto& switchCase : switchIns->cases()) {
         CaseHandle caseHandle = static_cast<CaseHandle>(&switchCase);
-        cases[caseHandle->getCaseValue()->getSExtValue()] = func->getBlockName(caseHandle->getCaseSuccessor());
+        if (caseHandle->getCaseSuccessor() != defBlock) {
+            values.push_back({caseHandle->getCaseValue()->getSExtValue(), caseHandle->getCaseSuccessor()});
+        }
+    }
+    std::sort(values.begin(), values.end(), [](const std::pair<int64_t, const llvm::BasicBlock*>& a, const std::pair<int64_t, const llvm::BasicBlock*>& b) {
+        return a.first < b.first;
+    });
+
+    std::vector<std::string> successors;
+    std::vector<SwitchExpr::CaseRange> cases;
+    llvm::DenseMap<const llvm::BasicBlock*, unsigned> successorIndices;
+    for (const auto& value : values) {
+        auto index = successorIndices.insert({value.second, successors.size()});
+        if (index.second) {
+            successors.push_back(func->getBlockName(value.second));
+        }
+
+        //ranges do not cross zero, so they are not empty even if the switched expression is unsigned in C
+        if (!cases.empty() && cases.back().successor == index.first->second && cases.back().high + 1 == value.first && value.first != 0) {
+            cases.back().high = value.first;
+        } else {
+            cases.push_back({value.first, value.first, index.first->second});
+        }
     }
 
     if (!isConstExpr) {
-        func->createExpr(&ins, std::make_unique<SwitchExpr>(cmp, def, cases));
+        func->createExpr(&ins, std::make_unique<SwitchExpr>(cmp, def, std::move(successors), std::move(cases)));
         addExpr(func->getExpr(&ins));
     } else {
-        func->createExpr(val, std::make_unique<SwitchExpr>(cmp, def, cases));
+        func->createExpr(val, std::make_unique<SwitchExpr>(cmp, def, std::move(successors), std::move(cases)));
     }
 }
 
@@ -456,37 +432,19 @@ void Block::parseAsmInst(const llvm::Instruction& ins, bool isConstExpr, const l
     }
 
     if (!isConstExpr) {
-        func->createExpr(&ins, std::make_unique<AsmExpr>(inst, std::vector<std::pair<std::string, Expr*>>(), std::vector<std::pair<std::string, Expr*>>(), ""));
+        func->createExpr(&ins, std::make_unique<AsmExpr>(inst, std::vector<std::pair<std::string, Expr*>>(), std::vector<std::pair<std::string, Expr*>>(), "", true));
         addExpr(func->getExpr(&ins));
     } else {
-        func->createExpr(val, std::make_unique<AsmExpr>(inst, std::vector<std::pair<std::string, Expr*>>(), std::vector<std::pair<std::string, Expr*>>(), ""));
+        func->createExpr(val, std::make_unique<AsmExpr>(inst, std::vector<std::pair<std::string, Expr*>>(), std::vector<std::pair<std::string, Expr*>>(), "", true));
     }
 }
 
 void Block::parseShiftInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val) {
-    if (!func->getExpr(ins.getOperand(0))) {
-        createConstantValue(ins.getOperand(0));
-    }
     Expr* val0 = func->getExpr(ins.getOperand(0));
-
-    if (!func->getExpr(ins.getOperand(1))) {
-        createConstantValue(ins.getOperand(1));
-    }
     Expr* val1 = func->getExpr(ins.getOperand(1));
 
     const llvm::Value* value = isConstExpr ? val : &ins;
-
-    switch (ins.getOpcode()) {
-    case llvm::Instruction::Shl:
-        func->createExpr(value, std::make_unique<ShlExpr>(val0, val1));
-        break;
-    case llvm::Instruction::LShr:
-        func->createExpr(value, std::make_unique<LshrExpr>(val0, val1));
-        break;
-    case llvm::Instruction::AShr:
-        func->createExpr(value, std::make_unique<AshrExpr>(val0, val1));
-        break;
-    }
+    func->createExpr(value, createBinaryExpr(ins.getOpcode(), val0, val1));
 }
 
 void Block::parseCallInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val) {
@@ -506,7 +464,7 @@ void Block::parseCallInstruction(const llvm::Instruction& ins, bool isConstExpr,
         }
 
         if (funcName.compare("llvm.trap") == 0 || funcName.compare("llvm.debugtrap") == 0) {
-            func->createExpr(&ins, std::make_unique<AsmExpr>("int3", std::vector<std::pair<std::string, Expr*>>(), std::vector<std::pair<std::string, Expr*>>(), ""));
+            func->createExpr(&ins, std::make_unique<AsmExpr>("int3", std::vector<std::pair<std::string, Expr*>>(), std::vector<std::pair<std::string, Expr*>>(), "", true));
             addExpr(func->getExpr(&ins));
             return;
         }
@@ -516,9 +474,17 @@ void Block::parseCallInstruction(const llvm::Instruction& ins, bool isConstExpr,
             return;
         }
 
+        if (llvm::isa<llvm::MemIntrinsic>(callInst)) {
+            parseMemIntrinsic(ins);
+            return;
+        }
+
         if (funcName.substr(0,4).compare("llvm") == 0) {
             if (isCFunc(getCFunc(funcName))) {
                 funcName = getCFunc(funcName);
+                if (isCMath(funcName)) {
+                    funcName = getCMathFunc(funcName, callInst->getCalledFunction()->getReturnType());
+                }
             } else {
                 std::replace(funcName.begin(), funcName.end(), '.', '_');
             }
@@ -533,36 +499,31 @@ void Block::parseCallInstruction(const llvm::Instruction& ins, bool isConstExpr,
             return;
         }
 
-        if (!func->getExpr(callInst->getCalledValue())) {
-            createConstantValue(callInst->getCalledValue());
-        }
-
-        if (!func->getExpr(callInst->getCalledValue())) {
-            createConstantValue(callInst->getCalledValue());
-        }
         funcValue = func->getExpr(callInst->getCalledValue());
     }
 
-    int i = 0;
     for (const llvm::Use& param : callInst->arg_operands()) {
-        //sometimes LLVM uses these functions with more arguments than their C counterparts
-        if ((funcName.compare("memcpy") == 0 || funcName.compare("memmove") == 0 || funcName.compare("memset") == 0)  && i == 3) {
-            break;
-        }
-
         if (!func->getExpr(param)) {
             createFuncCallParam(param);
         }
         params.push_back(func->getExpr(param));
-        i++;
     }
 
     if (funcName.compare("va_start") == 0) {
         params.push_back(func->lastArg);
     }
 
+    //tail call is emitted directly in the return statement that follows it
+    if (!isConstExpr && isReturnedTailCall(callInst)) {
+        func->createExpr(&ins, std::make_unique<CallExpr>(funcValue, funcName, params, type->clone()));
+        if (callInst->isMustTailCall()) {
+            func->program->hasMustTail = true;
+        }
+        return;
+    }
+
     //call function if it returns void, otherwise store function return value to a new variable and use this variable instead of function call
-    if (dynamic_cast<VoidType*>(type.get())) {
+    if (llvm::isa<VoidType>(type.get())) {
         func->createExpr(value, std::make_unique<CallExpr>(funcValue, funcName, params, type->clone()));
 
         if (!isConstExpr) {
@@ -581,20 +542,87 @@ void Block::parseCallInstruction(const llvm::Instruction& ins, bool isConstExpr,
     }
 }
 
+void Block::parseMemIntrinsic(const llvm::Instruction& ins) {
+    const llvm::MemIntrinsic* MI = llvm::cast<llvm::MemIntrinsic>(&ins);
+    const llvm::ConstantInt* length = llvm::dyn_cast<llvm::ConstantInt>(MI->getLength());
+
+    //copying or zeroing the whole struct is translated as struct assignment
+    if (length && !MI->isVolatile() && MI->getIntrinsicID() != llvm::Intrinsic::memmove) {
+        const llvm::Value* dest = MI->getRawDest()->stripPointerCasts();
+        llvm::Type* destType = dest->getType()->getPointerElementType();
+        const llvm::MemSetInst* MSI = llvm::dyn_cast<llvm::MemSetInst>(MI);
+        const llvm::ConstantInt* setValue = MSI ? llvm::dyn_cast<llvm::ConstantInt>(MSI->getValue()) : nullptr;
+        const llvm::Value* src = nullptr;
+
+        if (const llvm::MemTransferInst* MTI = llvm::dyn_cast<llvm::MemTransferInst>(MI)) {
+            src = MTI->getRawSource()->stripPointerCasts();
+        } else if (setValue && setValue->isZero()) {
+            src = llvm::Constant::getNullValue(destType);
+        }
+
+        if (src && destType->isStructTy() && func->getDataLayout().getTypeAllocSize(destType) == length->getZExtValue()
+                && (!llvm::isa<llvm::MemTransferInst>(MI) || src->getType() == dest->getType())) {
+            Expr* destExpr = func->getExpr(dest);
+            if (derefs.find(destExpr) == derefs.end()) {
+                derefs[destExpr] = std::make_unique<DerefExpr>(destExpr);
+            }
+
+            Expr* srcExpr = func->getExpr(src);
+            if (llvm::isa<llvm::MemTransferInst>(MI)) {
+                if (derefs.find(srcExpr) == derefs.end()) {
+                    derefs[srcExpr] = std::make_unique<DerefExpr>(srcExpr);
+                }
+                srcExpr = derefs[srcExpr].get();
+            }
+
+            func->createExpr(&ins, std::make_unique<AssignExpr>(derefs[destExpr].get(), srcExpr));
+            addExpr(func->getExpr(&ins));
+            return;
+        }
+    }
+
+    //other calls are translated as calls of builtins, volatile calls as calls of helper functions keeping the volatility
+    std::string funcName;
+    switch (MI->getIntrinsicID()) {
+    case llvm::Intrinsic::memcpy:
+        funcName = MI->isVolatile() ? "llvm2c_volatile_memmove" : "__builtin_memcpy";
+        break;
+    case llvm::Intrinsic::memmove:
+        funcName = MI->isVolatile() ? "llvm2c_volatile_memmove" : "__builtin_memmove";
+        break;
+    default:
+        funcName = MI->isVolatile() ? "llvm2c_volatile_memset" : "__builtin_memset";
+        break;
+    }
+
+    if (MI->isVolatile()) {
+        func->program->hasVolatileMem = true;
+    }
+
+    //LLVM intrinsics have additional arguments (alignment, volatility) that are not passed to the C functions
+    std::vector<Expr*> params;
+    for (unsigned i = 0; i < 3; i++) {
+        const llvm::Use& param = MI->getArgOperandUse(i);
+        if (!func->getExpr(param)) {
+            createFuncCallParam(param);
+        }
+        params.push_back(func->getExpr(param));
+    }
+
+    func->createExpr(&ins, std::make_unique<CallExpr>(nullptr, funcName, params, std::make_unique<VoidType>()));
+    addExpr(func->getExpr(&ins));
+}
+
 void Block::parseInlineASM(const llvm::Instruction& ins) {
     const auto callInst = llvm::cast<llvm::CallInst>(&ins);
     const auto IA = llvm::cast<llvm::InlineAsm>(callInst->getCalledValue());
 
-    std::string asmString = toRawString(IA->getAsmString());
-    std::vector<std::string> inputStrings;
-    std::vector<std::string> outputStrings;
-    std::string usedReg;
-
-    if (!IA->getConstraintString().empty()) {
-        outputStrings = getAsmOutputStrings(IA->ParseConstraints());
-        inputStrings = getAsmInputStrings(IA->ParseConstraints());
-        usedReg = getAsmUsedRegString(IA->ParseConstraints());
+    auto iter = func->program->parsedAsm.find(IA);
+    if (iter == func->program->parsedAsm.end()) {
+        iter = func->program->parsedAsm.insert({IA, parseAsm(IA)}).first;
     }
+    const ParsedAsm& parsed = iter->second;
+    const std::vector<std::string>& inputStrings = parsed.inputs;
 
     std::vector<Expr*> args;
     for (const llvm::Use& arg : callInst->arg_operands()) {
@@ -618,7 +646,7 @@ void Block::parseInlineASM(const llvm::Instruction& ins) {
             addExpr(vars[vars.size() - 1].get());
             addExpr(stores[stores.size() - 1].get());
         } else if (CE) {
-            if (llvm::isa<llvm::GetElementPtrInst>(CE->getAsInstruction())) {
+            if (CE->getOpcode() == llvm::Instruction::GetElementPtr) {
                 vars.push_back(std::make_unique<Value>(func->getVarName(), func->getExpr(arg.get())->getType()->clone()));
                 stores.push_back(std::make_unique<AssignExpr>(vars[vars.size() - 1].get(), func->getExpr(arg.get())));
                 args.push_back(vars[vars.size() - 1].get());
@@ -637,7 +665,7 @@ void Block::parseInlineASM(const llvm::Instruction& ins) {
     std::vector<std::pair<std::string, Expr*>> output;
     Expr* expr = nullptr;
     unsigned pos = 0;
-    for (const auto& str : outputStrings) {
+    for (const auto& str : parsed.outputs) {
         if (str.find('*') == std::string::npos) {
             output.push_back({str, expr});
         } else {
@@ -672,17 +700,14 @@ void Block::parseInlineASM(const llvm::Instruction& ins) {
         arg--;
     }
 
-    func->createExpr(&ins, std::make_unique<AsmExpr>(asmString, output, input, usedReg));
+    func->createExpr(&ins, std::make_unique<AsmExpr>(parsed.asmString, output, input, parsed.clobbers, parsed.isVolatile));
     addExpr(func->getExpr(&ins));
 }
 
 void Block::parseCastInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val) {
-    if (func->getExpr(ins.getOperand(0)) == nullptr) {
-        createConstantValue(ins.getOperand(0));
-    }
     Expr* expr = func->getExpr(ins.getOperand(0));
 
-    auto AE = dynamic_cast<AsmExpr*>(expr);
+    auto AE = llvm::dyn_cast_or_null<AsmExpr>(expr);
     //operand is used for initializing output in inline asm
     if (!expr || AE) {
         return;
@@ -701,14 +726,8 @@ void Block::parseSelectInstruction(const llvm::Instruction& ins, bool isConstExp
     const llvm::SelectInst* SI = llvm::cast<const llvm::SelectInst>(&ins);
     Expr* cond = func->getExpr(SI->getCondition());
 
-    if (!func->getExpr(ins.getOperand(1))) {
-        createConstantValue(ins.getOperand(1));
-    }
     Expr* val0 = func->getExpr(ins.getOperand(1));
 
-    if (!func->getExpr(ins.getOperand(2))) {
-        createConstantValue(ins.getOperand(2));
-    }
     Expr* val1 = func->getExpr(ins.getOperand(2));
 
     const llvm::Value* value = isConstExpr ? val : &ins;
@@ -718,9 +737,6 @@ void Block::parseSelectInstruction(const llvm::Instruction& ins, bool isConstExp
 void Block::parseGepInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val) {
     const llvm::GetElementPtrInst* gepInst = llvm::cast<llvm::GetElementPtrInst>(&ins);
 
-    if (!func->getExpr(gepInst->getOperand(0))) {
-        createConstantValue(gepInst->getOperand(0));
-    }
     Expr* expr = func->getExpr(gepInst->getOperand(0));
 
     llvm::Type* prevType = gepInst->getOperand(0)->getType();
@@ -734,9 +750,6 @@ void Block::parseGepInstruction(const llvm::Instruction& ins, bool isConstExpr,
     }
 
     for (auto it = llvm::gep_type_begin(gepInst); it != llvm::gep_type_end(gepInst); it++) {
-        if (!func->getExpr(it.getOperand())) {
-            createConstantValue(it.getOperand());
-        }
         Expr* index = func->getExpr(it.getOperand());
 
         if (prevType->isPointerTy()) {
@@ -770,32 +783,85 @@ void Block::parseGepInstruction(const llvm::Instruction& ins, bool isConstExpr,
 void Block::parseExtractValueInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val) {
     const llvm::ExtractValueInst* EVI = llvm::cast<const llvm::ExtractValueInst>(&ins);
 
-    std::vector<std::unique_ptr<Expr>> indices;
-    std::unique_ptr<Type> prevType = func->getType(ins.getOperand(0)->getType());
     Expr* expr = func->getExpr(ins.getOperand(0));
 
-    if (dynamic_cast<AsmExpr*>(expr)) {
+    //outputs of inline asm are handled in store instruction
+    if (llvm::dyn_cast_or_null<AsmExpr>(expr)) {
         return;
     }
 
-    for (unsigned idx : EVI->getIndices()) {
+    func->createExpr(isConstExpr ? val : &ins, createAggregateElement(expr, ins.getOperand(0)->getType(), EVI->getIndices()));
+}
+
+void Block::parseInsertValueInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val) {
+    const llvm::InsertValueInst* IVI = llvm::cast<const llvm::InsertValueInst>(&ins);
+    const llvm::Value* value = isConstExpr ? val : &ins;
+
+    //every insertvalue creates new temporary aggregate, which is a copy of the original one with one element changed
+    func->createExpr(value, std::make_unique<Value>(func->getVarName(), func->getType(IVI->getType())));
+    Expr* aggregate = func->getExpr(value);
+    if (!isConstExpr) {
+        addExpr(aggregate);
+    }
+
+    if (!llvm::isa<llvm::UndefValue>(IVI->getAggregateOperand())) {
+        Expr* original = func->getExpr(IVI->getAggregateOperand());
+
+        if (IVI->getType()->isArrayTy()) {
+            //arrays cannot be assigned in C
+            values.push_back(std::make_unique<Value>("sizeof(" + static_cast<Value*>(aggregate)->valueName + ")", std::make_unique<LongType>(true)));
+            std::vector<Expr*> params = {aggregate, original, values[values.size() - 1].get()};
+            stores.push_back(std::make_unique<CallExpr>(nullptr, "__builtin_memcpy", params, std::make_unique<VoidType>()));
+        } else {
+            stores.push_back(std::make_unique<AssignExpr>(aggregate, original));
+        }
+
+        if (!isConstExpr) {
+            addExpr(stores[stores.size() - 1].get());
+        }
+    }
+
+    Expr* inserted = func->getExpr(IVI->getInsertedValueOperand());
+
+    aggregateElements.push_back(createAggregateElement(aggregate, IVI->getType(), IVI->getIndices()));
+    Expr* element = aggregateElements[aggregateElements.size() - 1].get();
+
+    if (llvm::ExtractValueInst::getIndexedType(IVI->getType(), IVI->getIndices())->isArrayTy()) {
+        //arrays cannot be assigned in C
+        values.push_back(std::make_unique<Value>("sizeof(" + element->toString() + ")", std::make_unique<LongType>(true)));
+        std::vector<Expr*> params = {element, inserted, values[values.size() - 1].get()};
+        stores.push_back(std::make_unique<CallExpr>(nullptr, "__builtin_memcpy", params, std::make_unique<VoidType>()));
+    } else {
+        stores.push_back(std::make_unique<AssignExpr>(element, inserted));
+    }
+
+    if (!isConstExpr) {
+        addExpr(stores[stores.size() - 1].get());
+    }
+}
+
+std::unique_ptr<Expr> Block::createAggregateElement(Expr* aggregate, llvm::Type* type, llvm::ArrayRef<unsigned> idxs) {
+    std::vector<std::unique_ptr<Expr>> indices;
+    Expr* expr = aggregate;
+
+    for (unsigned idx : idxs) {
         std::unique_ptr<Expr> element = nullptr;
 
-        if (StructType* ST = dynamic_cast<StructType*>(prevType.get())) {
-            element = std::make_unique<StructElement>(func->getStruct(ST->name), expr, idx);
+        if (const llvm::StructType* ST = llvm::dyn_cast<llvm::StructType>(type)) {
+            element = std::make_unique<StructElement>(func->getStruct(ST), expr, idx);
         }
 
-        if (dynamic_cast<ArrayType*>(prevType.get())) {
+        if (type->isArrayTy()) {
             values.push_back(std::make_unique<Value>(std::to_string(idx), std::make_unique<IntType>(true)));
             element = std::make_unique<ArrayElement>(expr, values[values.size() - 1].get());
         }
 
         indices.push_back(std::move(element));
-        prevType = indices[indices.size() - 1]->getType()->clone();
+        type = llvm::ExtractValueInst::getIndexedType(type, idx);
         expr = indices[indices.size() - 1].get();
     }
 
-    func->createExpr(isConstExpr ? val : &ins, std::make_unique<ExtractValueExpr>(indices));
+    return std::make_unique<ExtractValueExpr>(indices);
 }
 
 void Block::parseLLVMInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val) {
@@ -874,6 +940,9 @@ void Block::parseLLVMInstruction(const llvm::Instruction& ins, bool isConstExpr,
     case llvm::Instruction::ExtractValue:
         parseExtractValueInstruction(ins, isConstExpr, val);
         break;
+    case llvm::Instruction::InsertValue:
+        parseInsertValueInstruction(ins, isConstExpr, val);
+        break;
     default:
         llvm::outs() << "File contains unsupported instruction!\n";
         llvm::outs() << ins << "\n";
@@ -896,7 +965,7 @@ void Block::setMetadataInfo(const llvm::CallInst* ins) {
         }
 
         if (type && type->getName().str().compare(0, 8, "unsigned") == 0) {
-            if (IntegerType* IT = dynamic_cast<IntegerType*>(variable->getType())) {
+            if (IntegerType* IT = llvm::dyn_cast_or_null<IntegerType>(variable->getType())) {
                 IT->unsignedType = true;
             }
         }
@@ -905,81 +974,45 @@ void Block::setMetadataInfo(const llvm::CallInst* ins) {
 
 void Block::unsetAllInit() {
     for (auto expr : expressions) {
-        if (Value* val = dynamic_cast<Value*>(expr)) {
+        if (Value* val = llvm::dyn_cast<Value>(expr)) {
             val->init = false;
         }
     }
 }
 
-void Block::createConstantValue(const llvm::Value* val) {
-    //undefined value is translated as zero, only for experimental purposes (this value cannot occur in LLVM generated from C)
-    if (llvm::isa<llvm::UndefValue>(val)) {
-        func->createExpr(val, std::make_unique<Value>("0", func->getType(val->getType())));
-        return;
-    }
-
-    if (auto CPN = llvm::dyn_cast<llvm::ConstantPointerNull>(val)) {
-        func->createExpr(val, std::make_unique<Value>("0", func->getType(CPN->getType())));
-        return;
-    }
-
-    if (auto CI = llvm::dyn_cast<llvm::ConstantInt>(val)) {
-        std::string value;
-        if (CI->getBitWidth() > 64) {
-            const llvm::APInt& API = CI->getValue();
-            value = std::to_string(API.getLimitedValue());
-        } else if (CI->getBitWidth() == 1) { //bool in LLVM
-            value = std::to_string(-1 * CI->getSExtValue());
-        } else {
-            value = std::to_string(CI->getSExtValue());
-        }
-
-        func->createExpr(val, std::make_unique<Value>(value, std::make_unique<IntType>(false)));
-        return;
-    }
-
-    if (auto CFP = llvm::dyn_cast<llvm::ConstantFP>(val)) {
-        if (CFP->isInfinity()) {
-            func->createExpr(val, std::make_unique<Value>("__builtin_inff ()", std::make_unique<FloatType>()));
-        } else if (CFP->isNaN()){
-            func->createExpr(val, std::make_unique<Value>("__builtin_nanf (\"\")", std::make_unique<FloatType>()));
-        } else {
-            std::string CFPvalue = std::to_string(CFP->getValueAPF().convertToDouble());
-            if (CFPvalue.compare("-nan") == 0) {
-                CFPvalue = "-(__builtin_nanf (\"\"))";
-            } else {
-                llvm::SmallVector<char, 32> string;
-                CFPvalue = "";
-                CFP->getValueAPF().toString(string, 32, 0);
-                for (unsigned i = 0; i < string.size(); i++) {
-                    CFPvalue += string[i];
-                }
-            }
-
-            func->createExpr(val, std::make_unique<Value>(CFPvalue, std::make_unique<FloatType>()));
-        }
-        return;
-    }
-
-    if (auto CE = llvm::dyn_cast<llvm::ConstantExpr>(val)) {
-        parseLLVMInstruction(*CE->getAsInstruction(), true, val);
-    }
-}
-
 bool Block::isCFunc(const std::string& func) {
     return C_FUNCTIONS.find(func) != C_FUNCTIONS.end();
 }
 
 std::string Block::getCFunc(const std::string& func) {
-    std::regex function("llvm\\.(\\w+)(\\..+){0,1}");
-    std::smatch match;
-    if (std::regex_search(func, match, function)) {
-        return match[1].str();
+    //name of the function is the identifier following "llvm.", e.g. "memcpy" in "llvm.memcpy.p0i8.p0i8.i64"
+    llvm::StringRef name = func;
+    for (size_t pos = name.find("llvm."); pos != llvm::StringRef::npos; pos = name.find("llvm.", pos + 1)) {
+        llvm::StringRef identifier = name.drop_front(pos + 5).take_while([](char c) {
+            return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+        });
+
+        if (!identifier.empty()) {
+            return identifier.str();
+        }
     }
 
     return "";
 }
 
+std::string Block::getCMathFunc(const std::string& func, const llvm::Type* type) {
+    std::string variant;
+    if (type->isFloatTy()) {
+        variant = func + "f";
+    } else if (type->isX86_FP80Ty()) {
+        variant = func + "l";
+    } else {
+        return func;
+    }
+
+    return getLibcFunction(variant) ? variant : func;
+}
+
 bool Block::isVoidType(llvm::DITypeRef type) {
     if (llvm::DIDerivedType* dtype = llvm::dyn_cast<llvm::DIDerivedType>(type)) {
         if (!dtype->getBaseType()) {
@@ -1000,24 +1033,69 @@ bool Block::isVoidType(llvm::DITypeRef type) {
     return false;
 }
 
+bool Block::isReturnedTailCall(const llvm::CallInst* callInst) const {
+    if (!callInst->isTailCall() || llvm::isa<llvm::InlineAsm>(callInst->getCalledValue())) {
+        return false;
+    }
+
+    const llvm::ReturnInst* RI = llvm::dyn_cast_or_null<llvm::ReturnInst>(callInst->getNextNode());
+    if (!RI) {
+        return false;
+    }
+
+    if (RI->getNumOperands() == 0) {
+        //returning call of void function is not valid C, it is used only if the call must be tail call
+        return callInst->getType()->isVoidTy() && callInst->isMustTailCall();
+    }
+
+    return RI->getOperand(0) == callInst && callInst->hasOneUse();
+}
+
+Expr* Block::createAlignedPointer(Expr* pointer, const llvm::Value* ptrValue, unsigned align) {
+    //variables and global variables are already declared with their alignment
+    if (llvm::isa<llvm::AllocaInst>(ptrValue) || llvm::isa<llvm::GlobalVariable>(ptrValue)) {
+        return pointer;
+    }
+
+    llvm::Type* accessType = ptrValue->getType()->getPointerElementType();
+    if (!accessType->isSized() || align <= func->getDataLayout().getABITypeAlignment(accessType)) {
+        return pointer;
+    }
+
+    values.push_back(std::make_unique<Value>(std::to_string(align), std::make_unique<IntType>(false)));
+    std::vector<Expr*> params = {pointer, values[values.size() - 1].get()};
+    callExprMap.push_back(std::make_unique<CallExpr>(nullptr, "__builtin_assume_aligned", params, std::make_unique<PointerType>(std::make_unique<VoidType>())));
+    casts.push_back(std::make_unique<CastExpr>(callExprMap[callExprMap.size() - 1].get(), func->getType(ptrValue->getType())));
+
+    return casts[casts.size() - 1].get();
+}
+
 void Block::createFuncCallParam(const llvm::Use& param) {
-    if (llvm::PointerType* PT = llvm::dyn_cast<llvm::PointerType>(param->getType())) {
-        if (llvm::isa<llvm::ConstantPointerNull>(param)) {
-            createConstantValue(param);
-        } else if (PT->getElementType()->isFunctionTy() && !param->getName().empty()) {
-            func->createExpr(param, std::make_unique<Value>(param->getName().str(), std::make_unique<VoidType>()));
-        } else {
-            createConstantValue(param);
-        }
-    } else {
-        createConstantValue(param);
+    llvm::PointerType* PT = llvm::dyn_cast<llvm::PointerType>(param->getType());
+    if (PT && PT->getElementType()->isFunctionTy() && !param->getName().empty()) {
+        func->createExpr(param, std::make_unique<Value>(param->getName().str(), std::make_unique<VoidType>()));
+    }
+}
+
+ParsedAsm Block::parseAsm(const llvm::InlineAsm* IA) const {
+    ParsedAsm parsed;
+    parsed.asmString = toRawString(IA->getAsmString());
+    parsed.isVolatile = IA->hasSideEffects();
+
+    if (!IA->getConstraintString().empty()) {
+        llvm::InlineAsm::ConstraintInfoVector info = IA->ParseConstraints();
+        parsed.outputs = getAsmOutputStrings(info);
+        parsed.inputs = getAsmInputStrings(info);
+        parsed.clobbers = getAsmUsedRegString(info);
     }
+
+    return parsed;
 }
 
-std::vector<std::string> Block::getAsmOutputStrings(llvm::InlineAsm::ConstraintInfoVector info) const {
+std::vector<std::string> Block::getAsmOutputStrings(const llvm::InlineAsm::ConstraintInfoVector& info) const {
     std::vector<std::string> ret;
 
-    for (llvm::InlineAsm::ConstraintInfoVector::iterator iter = info.begin(); iter != info.end(); iter++) {
+    for (llvm::InlineAsm::ConstraintInfoVector::const_iterator iter = info.begin(); iter != info.end(); iter++) {
         if (iter->Type != llvm::InlineAsm::isOutput) {
             continue;
         }
@@ -1073,10 +1151,10 @@ std::vector<std::string> Block::getAsmOutputStrings(llvm::InlineAsm::ConstraintI
     return ret;
 }
 
-std::vector<std::string> Block::getAsmInputStrings(llvm::InlineAsm::ConstraintInfoVector info) const {
+std::vector<std::string> Block::getAsmInputStrings(const llvm::InlineAsm::ConstraintInfoVector& info) const {
     std::vector<std::string> ret;
 
-    for (llvm::InlineAsm::ConstraintInfoVector::iterator iter = info.begin(); iter != info.end(); iter++) {
+    for (llvm::InlineAsm::ConstraintInfoVector::const_iterator iter = info.begin(); iter != info.end(); iter++) {
         if (iter->Type != llvm::InlineAsm::isInput) {
             continue;
         }
@@ -1119,14 +1197,17 @@ std::string Block::getRegisterString(const std::string& str) const {
     return ret;
 }
 
-std::string Block::getAsmUsedRegString(llvm::InlineAsm::ConstraintInfoVector info) const {
-    static std::vector<std::string> CLOBBER = {"memory", "rax", "eax", "ax", "al", "rbx", "ebx", "bx", "bl", "rcx", "ecx", "cx",
-                                               "cl", "rdx", "edx", "dx", "dl", "rsi", "esi", "si", "rdi", "edi", "di"};
+std::string Block::getAsmUsedRegString(const llvm::InlineAsm::ConstraintInfoVector& info) const {
+    static std::set<std::string> CLOBBER = {"rax", "eax", "ax", "al", "rbx", "ebx", "bx", "bl", "rcx", "ecx", "cx", "cl",
+                                            "rdx", "edx", "dx", "dl", "rsi", "esi", "si", "sil", "rdi", "edi", "di", "dil",
+                                            "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15",
+                                            "r8d", "r9d", "r10d", "r11d", "r12d", "r13d", "r14d", "r15d",
+                                            "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7",
+                                            "xmm8", "xmm9", "xmm10", "xmm11", "xmm12", "xmm13", "xmm14", "xmm15"};
 
-    std::string ret;
-    bool first = true;
+    std::vector<std::string> clobbers;
 
-    for (llvm::InlineAsm::ConstraintInfoVector::iterator iter = info.begin(); iter != info.end(); iter++) {
+    for (llvm::InlineAsm::ConstraintInfoVector::const_iterator iter = info.begin(); iter != info.end(); iter++) {
         if (iter->Type != llvm::InlineAsm::isClobber) {
             continue;
         }
@@ -1134,18 +1215,29 @@ std::string Block::getAsmUsedRegString(llvm::InlineAsm::ConstraintInfoVector inf
         std::string clobber = iter->Codes[0];
         clobber = clobber.substr(1, clobber.size() - 2);
 
-        if (std::find(CLOBBER.begin(), CLOBBER.end(), clobber) != CLOBBER.end()) {
-            if (!first) {
-                ret += ", ";
-            }
-            first = false;
+        //memory is clobbered only if the IR says so, otherwise the C compiler may keep values in registers across the asm;
+        //dirflag and fpsr are added by clang to every x86 asm and they are implicit in GCC
+        if (clobber.compare("memory") == 0) {
+            clobber = "\"memory\"";
+        } else if (clobber.compare("flags") == 0 || clobber.compare("eflags") == 0) {
+            clobber = "\"cc\"";
+        } else if (CLOBBER.find(clobber) != CLOBBER.end()) {
+            clobber = "\"%" + clobber + "\"";
+        } else {
+            continue;
+        }
 
-            ret += "\"";
-            if (clobber.compare("memory") != 0) {
-                ret += "%";
-            }
-            ret += clobber + "\"";
+        if (std::find(clobbers.begin(), clobbers.end(), clobber) == clobbers.end()) {
+            clobbers.push_back(clobber);
+        }
+    }
+
+    std::string ret;
+    for (const auto& clobber : clobbers) {
+        if (!ret.empty()) {
+            ret += ", ";
         }
+        ret += clobber;
     }
 
     return ret;
@@ -1200,3 +1292,78 @@ std::string Block::toRawString(const std::string& str) const {
 bool Block::isCMath(const std::string& func) {
     return C_MATH.find(func) != C_MATH.end();
 }
+
+std::unique_ptr<Expr> Block::createBinaryExpr(unsigned opcode, Expr* left, Expr* right) {
+    switch (opcode) {
+    case llvm::Instruction::Add:
+    case llvm::Instruction::FAdd:
+        return std::make_unique<AddExpr>(left, right);
+    case llvm::Instruction::Sub:
+    case llvm::Instruction::FSub:
+        return std::make_unique<SubExpr>(left, right);
+    case llvm::Instruction::Mul:
+    case llvm::Instruction::FMul:
+        return std::make_unique<MulExpr>(left, right);
+    case llvm::Instruction::SDiv:
+    case llvm::Instruction::UDiv:
+    case llvm::Instruction::FDiv:
+        return std::make_unique<DivExpr>(left, right);
+    case llvm::Instruction::SRem:
+    case llvm::Instruction::URem:
+    case llvm::Instruction::FRem:
+        return std::make_unique<RemExpr>(left, right);
+    case llvm::Instruction::And:
+        return std::make_unique<AndExpr>(left, right);
+    case llvm::Instruction::Or:
+        return std::make_unique<OrExpr>(left, right);
+    case llvm::Instruction::Xor:
+        return std::make_unique<XorExpr>(left, right);
+    case llvm::Instruction::Shl:
+        return std::make_unique<ShlExpr>(left, right);
+    case llvm::Instruction::LShr:
+        return std::make_unique<LshrExpr>(left, right);
+    case llvm::Instruction::AShr:
+        return std::make_unique<AshrExpr>(left, right);
+    }
+
+    return nullptr;
+}
+
+std::unique_ptr<Expr> Block::createCmpExpr(llvm::CmpInst::Predicate predicate, Expr* left, Expr* right) {
+    switch(predicate) {
+    case llvm::CmpInst::ICMP_EQ:
+    case llvm::CmpInst::FCMP_OEQ:
+    case llvm::CmpInst::FCMP_UEQ:
+        return std::make_unique<CmpExpr>(left, right, "==", false);
+    case llvm::CmpInst::ICMP_NE:
+    case llvm::CmpInst::FCMP_ONE:
+    case llvm::CmpInst::FCMP_UNE:
+        return std::make_unique<CmpExpr>(left, right, "!=", false);
+    case llvm::CmpInst::ICMP_UGT:
+    case llvm::CmpInst::ICMP_SGT:
+    case llvm::CmpInst::FCMP_UGT:
+    case llvm::CmpInst::FCMP_OGT:
+        return std::make_unique<CmpExpr>(left, right, ">", false);
+    case llvm::CmpInst::ICMP_UGE:
+    case llvm::CmpInst::ICMP_SGE:
+    case llvm::CmpInst::FCMP_OGE:
+    case llvm::CmpInst::FCMP_UGE:
+        return std::make_unique<CmpExpr>(left, right, ">=", false);
+    case llvm::CmpInst::ICMP_ULT:
+    case llvm::CmpInst::ICMP_SLT:
+    case llvm::CmpInst::FCMP_OLT:
+    case llvm::CmpInst::FCMP_ULT:
+        return std::make_unique<CmpExpr>(left, right, "<", false);
+    case llvm::CmpInst::ICMP_ULE:
+    case llvm::CmpInst::ICMP_SLE:
+    case llvm::CmpInst::FCMP_OLE:
+    case llvm::CmpInst::FCMP_ULE:
+        return std::make_unique<CmpExpr>(left, right, "<=", false);
+    case llvm::CmpInst::FCMP_FALSE:
+        return std::make_unique<Value>("0", std::make_unique<IntegerType>("int", false));
+    case llvm::CmpInst::FCMP_TRUE:
+        return std::make_unique<Value>("1", std::make_unique<IntegerType>("int", false));
+    default:
+        throw std::invalid_argument("FCMP ORD/UNO and BAD PREDICATE not supported!");
+    }
+}
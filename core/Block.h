@@ -12,6 +12,18 @@
 
 class Func;
 
+/**
+ * @brief The ParsedAsm struct contains inline asm translated into the GCC syntax. It does not depend on operands,
+ * so it is created only once for every llvm::InlineAsm.
+ */
+struct ParsedAsm {
+    std::string asmString; //asm string with GCC operand references
+    std::vector<std::string> outputs; //output constraints
+    std::vector<std::string> inputs; //input constraints
+    std::string clobbers; //clobbered registers, "cc" and "memory"
+    bool isVolatile; //asm has side effects, which cannot be deduced from outputs
+};
+
 /**
  * @brief The Block class represents one of the block of the LLVM function.
  */
@@ -35,12 +47,13 @@ private:
     //alloca expressions
     llvm::DenseMap<const llvm::Value*, std::unique_ptr<Value>> valueMap; //map of Values used in parsing alloca instruction
 
-    //extractvalue expressions
-    std::vector<std::unique_ptr<Value>> values; //Vector of Values used in parsing extractvalue
+    //extractvalue and insertvalue expressions
+    std::vector<std::unique_ptr<Value>> values; //Vector of Values used in parsing extractvalue, insertvalue and alignment of pointers
+    std::vector<std::unique_ptr<Expr>> aggregateElements; //Vector of ExtractValueExpr used as assigned elements in parsing insertvalue
 
     //inline asm and load expressions
     std::vector<std::unique_ptr<Expr>> vars; //Vector of Values used in parsing inline asm and load
-    std::vector<std::unique_ptr<Expr>> stores; //Vector of EqualsExpr used in parsing inline asm and load
+    std::vector<std::unique_ptr<Expr>> stores; //Vector of EqualsExpr used in parsing inline asm, load and insertvalue
     std::vector<std::unique_ptr<Expr>> loadDerefs; //Vector of DerefExpr used in parsing load
 
     //call expressions
@@ -167,6 +180,24 @@ private:
      */
     void parseExtractValueInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val);
 
+    /**
+     * @brief parseInsertValueInstruction Parses insertvalue instruction into new temporary aggregate
+     * which is assigned the original aggregate and then the inserted element.
+     * @param ins insertvalue instruction
+     * @param isConstExpr indicated that ConstantExpr is being parsed
+     * @param val pointer to the original ConstantExpr (ins contains ConstantExpr as instruction)
+     */
+    void parseInsertValueInstruction(const llvm::Instruction& ins, bool isConstExpr, const llvm::Value* val);
+
+    /**
+     * @brief createAggregateElement Creates access to the element of aggregate (struct or array).
+     * @param aggregate Expr representing the aggregate
+     * @param type LLVM type of the aggregate
+     * @param idxs Indices of the element, as used by extractvalue and insertvalue
+     * @return ExtractValueExpr containing sequence of StructElement and ArrayElement expressions
+     */
+    std::unique_ptr<Expr> createAggregateElement(Expr* aggregate, llvm::Type* type, llvm::ArrayRef<unsigned> idxs);
+
     /**
      * @brief parseLLVMInstruction Calls corresponding parse method for given instruction.
      * @param ins Instruction for parsing
@@ -182,16 +213,17 @@ private:
     void parseInlineASM(const llvm::Instruction& ins);
 
     /**
-     * @brief setMetadataInfo Uses metadata to add additional information to variables (e.g. original name, unsigness)
-     * @param ins Call instruction that called llvm.dbg.declare
+     * @brief parseMemIntrinsic Parses call of llvm.memcpy, llvm.memmove or llvm.memset. Copying or zeroing
+     * of the whole struct is translated as struct assignment, other calls as calls of builtin functions.
+     * @param ins Call instruction calling the intrinsic
      */
-    void setMetadataInfo(const llvm::CallInst* ins);
+    void parseMemIntrinsic(const llvm::Instruction& ins);
 
     /**
-     * @brief createConstantValue Creates Value for given ConstantInt or ConstantFP and inserts it into exprMap.
-     * @param val constant value
+     * @brief setMetadataInfo Uses metadata to add additional information to variables (e.g. original name, unsigness)
+     * @param ins Call instruction that called llvm.dbg.declare
      */
-    void createConstantValue(const llvm::Value* val);
+    void setMetadataInfo(const llvm::CallInst* ins);
 
     /**
      * @brief isVoidType Parses metadata about variable type. Returns wether the type is void or not.
@@ -201,24 +233,49 @@ private:
     bool isVoidType(llvm::DITypeRef type);
 
     /**
-     * @brief createFuncCallParam Creates new Expr for parameter of function call.
+     * @brief isReturnedTailCall Determines whether the call is tail call whose result is immediately returned.
+     * Such call is translated as a part of the return statement, so the C compiler can perform sibling call optimization.
+     * @param callInst Call instruction
+     * @return True if the call is translated as "return call", false otherwise
+     */
+    bool isReturnedTailCall(const llvm::CallInst* callInst) const;
+
+    /**
+     * @brief createAlignedPointer Wraps pointer used by over-aligned load or store into __builtin_assume_aligned,
+     * so the alignment known in LLVM is not lost in C.
+     * @param pointer Expr representing the pointer
+     * @param ptrValue LLVM pointer operand of the load or store
+     * @param align Alignment of the load or store
+     * @return Cast of __builtin_assume_aligned call if the access is over-aligned, pointer otherwise
+     */
+    Expr* createAlignedPointer(Expr* pointer, const llvm::Value* ptrValue, unsigned align);
+
+    /**
+     * @brief createFuncCallParam Creates new Expr for named function pointer used as a parameter of function call.
      * @param param Parameter of function call
      */
     void createFuncCallParam(const llvm::Use& param);
 
+    /**
+     * @brief parseAsm Parses asm string and constraint string of inline asm.
+     * @param IA Inline asm
+     * @return Inline asm in the GCC syntax
+     */
+    ParsedAsm parseAsm(const llvm::InlineAsm* IA) const;
+
     /**
      * @brief getAsmOutputString Parses asm constraint string to get output operands.
      * @param info ConstraintInfoVector containing parsed asm constraint string
      * @return Strings containing output operand for inline assembler
      */
-    std::vector<std::string> getAsmOutputStrings(llvm::InlineAsm::ConstraintInfoVector info) const;
+    std::vector<std::string> getAsmOutputStrings(const llvm::InlineAsm::ConstraintInfoVector& info) const;
 
     /**
      * @brief getAsmInputStrings Parses asm constraint string to get input operands.
      * @param info ConstraintInfoVector containing parsed asm constraint string
      * @return Vector of strings containing input operand for inline assembler
      */
-    std::vector<std::string> getAsmInputStrings(llvm::InlineAsm::ConstraintInfoVector info) const;
+    std::vector<std::string> getAsmInputStrings(const llvm::InlineAsm::ConstraintInfoVector& info) const;
 
     /**
      * @brief getRegisterString Parses string containing register label from LLVM to C.
@@ -232,7 +289,7 @@ private:
      * @param info ConstraintInfoVector containing parsed asm constraint string
      * @return String containing used registers
      */
-    std::string getAsmUsedRegString(llvm::InlineAsm::ConstraintInfoVector info) const;
+    std::string getAsmUsedRegString(const llvm::InlineAsm::ConstraintInfoVector& info) const;
 
     /**
      * @brief toRawString Converts string to its raw format (including escape chars etc.)
@@ -292,4 +349,31 @@ public:
      * @return string containing name of the C function
      */
     static std::string getCFunc(const std::string& func);
+
+    /**
+     * @brief getCMathFunc Returns name of the variant of the math function for given floating point type,
+     * e.g. "sqrtf" for float and "sqrtl" for long double.
+     * @param func Name of the C math function
+     * @param type Return type of the intrinsic
+     * @return Name of the variant, or func if there is no variant for the type
+     */
+    static std::string getCMathFunc(const std::string& func, const llvm::Type* type);
+
+    /**
+     * @brief createBinaryExpr Creates expression for binary or shift operation with given opcode.
+     * @param opcode LLVM opcode of the operation
+     * @param left Left operand
+     * @param right Right operand
+     * @return Expression corresponding to the operation, nullptr if the opcode is not binary operation
+     */
+    static std::unique_ptr<Expr> createBinaryExpr(unsigned opcode, Expr* left, Expr* right);
+
+    /**
+     * @brief createCmpExpr Creates expression for comparison with given predicate.
+     * @param predicate LLVM predicate of the comparison
+     * @param left Left operand
+     * @param right Right operand
+     * @return Expression corresponding to the comparison
+     */
+    static std::unique_ptr<Expr> createCmpExpr(llvm::CmpInst::Predicate predicate, Expr* left, Expr* right);
 };
@@ -0,0 +1,232 @@
+#include "Compression.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+//size of chunks in which data are passed to zlib
+const static std::size_t CHUNK_SIZE = 1 << 18;
+
+bool isGzip(llvm::StringRef data) {
+    return data.size() >= 2 && static_cast<unsigned char>(data[0]) == 0x1f && static_cast<unsigned char>(data[1]) == 0x8b;
+}
+
+bool hasGzipExtension(llvm::StringRef fileName) {
+    return fileName.endswith(".gz");
+}
+
+#ifdef HAVE_ZLIB
+
+std::unique_ptr<llvm::MemoryBuffer> decompressGzip(llvm::StringRef data, const std::string& name) {
+    z_stream stream = {};
+    //16 selects the gzip format
+    if (inflateInit2(&stream, 16 + MAX_WBITS) != Z_OK) {
+        throw std::invalid_argument("Error loading module - zlib cannot be initialized:\n" + name + "\n");
+    }
+
+    //the gzip trailer contains size of the (last) member modulo 2^32, which is usually the size of the whole output,
+    //so the output is decompressed directly into the returned buffer
+    std::size_t capacity = CHUNK_SIZE;
+    if (data.size() >= 4) {
+        const unsigned char* trailer = reinterpret_cast<const unsigned char*>(data.end() - 4);
+        uint32_t size = trailer[0] | trailer[1] << 8 | trailer[2] << 16 | static_cast<uint32_t>(trailer[3]) << 24;
+        //deflate cannot compress more than 1032 times, larger sizes are not trusted
+        capacity = std::min<uint64_t>(size, data.size() * 1032);
+    }
+
+    std::unique_ptr<llvm::WritableMemoryBuffer> result = llvm::WritableMemoryBuffer::getNewUninitMemBuffer(capacity, name);
+    std::size_t size = 0;
+    bool full = false; //inflate stopped because there was no space left in the output
+    const char* next = data.begin();
+    int status = result ? Z_OK : Z_MEM_ERROR;
+    while (result) {
+        if (stream.avail_in == 0 && next != data.end()) {
+            std::size_t chunk = std::min<std::size_t>(CHUNK_SIZE, data.end() - next);
+            stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(next));
+            stream.avail_in = chunk;
+            next += chunk;
+        }
+
+        //full output is moved into a buffer twice as large, it is not grown in advance, so that the output
+        //stays in the buffer of the size from the trailer
+        if (full && size == result->getBufferSize()) {
+            auto larger = llvm::WritableMemoryBuffer::getNewUninitMemBuffer(std::max(size * 2, CHUNK_SIZE), name);
+            if (!larger) {
+                status = Z_MEM_ERROR;
+                break;
+            }
+            std::copy(result->getBufferStart(), result->getBufferEnd(), larger->getBufferStart());
+            result = std::move(larger);
+        }
+
+        std::size_t available = std::min<std::size_t>(result->getBufferSize() - size, CHUNK_SIZE);
+        stream.next_out = reinterpret_cast<Bytef*>(result->getBufferStart() + size);
+        stream.avail_out = available;
+
+        status = inflate(&stream, Z_NO_FLUSH);
+        size += available - stream.avail_out;
+        full = stream.avail_out == 0;
+
+        if (status == Z_STREAM_END) {
+            //concatenated gzip files are decompressed as one file and bytes following the last member (e.g. padding
+            //of tape archives) are ignored, as gzip does
+            llvm::StringRef rest = data.drop_front(next - data.begin() - stream.avail_in);
+            if (!isGzip(rest)) {
+                break;
+            }
+            inflateReset(&stream);
+            continue;
+        }
+
+        if (status != Z_OK && !(status == Z_BUF_ERROR && (full || stream.avail_in > 0 || next != data.end()))) {
+            break;
+        }
+    }
+
+    inflateEnd(&stream);
+
+    if (status == Z_MEM_ERROR) {
+        throw std::invalid_argument("Error loading module - not enough memory for decompression:\n" + name + "\n");
+    }
+    if (status != Z_STREAM_END) {
+        throw std::invalid_argument("Error loading module - corrupted or truncated gzip file:\n" + name + "\n");
+    }
+
+    if (size == result->getBufferSize()) {
+        return std::move(result);
+    }
+
+    //the size in the trailer was wrong, the buffer must end right after the data to be null terminated
+    auto exact = llvm::WritableMemoryBuffer::getNewUninitMemBuffer(size, name);
+    if (!exact) {
+        throw std::invalid_argument("Error loading module - not enough memory for decompression:\n" + name + "\n");
+    }
+    std::copy(result->getBufferStart(), result->getBufferStart() + size, exact->getBufferStart());
+    return std::move(exact);
+}
+
+struct GzipFileBuffer::State {
+    z_stream stream = {};
+};
+
+GzipFileBuffer::GzipFileBuffer(const std::string& fileName)
+    : state(std::make_unique<State>()),
+      input(CHUNK_SIZE),
+      output(CHUNK_SIZE) {
+    file = std::fopen(fileName.c_str(), "wb");
+    if (!file) {
+        throw std::invalid_argument("Output file cannot be opened!");
+    }
+
+    //16 selects the gzip format, level 6 is the default of gzip
+    if (deflateInit2(&state->stream, 6, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        std::fclose(file);
+        throw std::invalid_argument("zlib cannot be initialized!");
+    }
+
+    setp(input.data(), input.data() + input.size());
+}
+
+GzipFileBuffer::~GzipFileBuffer() {
+    close();
+}
+
+bool GzipFileBuffer::compress(bool finish) {
+    if (failed) {
+        return false;
+    }
+
+    state->stream.next_in = reinterpret_cast<Bytef*>(pbase());
+    state->stream.avail_in = pptr() - pbase();
+
+    int status;
+    do {
+        state->stream.next_out = reinterpret_cast<Bytef*>(output.data());
+        state->stream.avail_out = output.size();
+
+        status = deflate(&state->stream, finish ? Z_FINISH : Z_NO_FLUSH);
+        if (status == Z_STREAM_ERROR) {
+            failed = true;
+            return false;
+        }
+
+        std::size_t size = output.size() - state->stream.avail_out;
+        if (std::fwrite(output.data(), 1, size, file) != size) {
+            failed = true;
+            return false;
+        }
+    } while (state->stream.avail_out == 0 || (finish && status != Z_STREAM_END));
+
+    setp(input.data(), input.data() + input.size());
+    return true;
+}
+
+int GzipFileBuffer::overflow(int c) {
+    if (!compress(false)) {
+        return traits_type::eof();
+    }
+
+    if (c != traits_type::eof()) {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+
+    return traits_type::not_eof(c);
+}
+
+int GzipFileBuffer::sync() {
+    //data are flushed only by close, flushing of zlib in the middle of the stream would make the compression worse
+    return failed ? -1 : 0;
+}
+
+bool GzipFileBuffer::close() {
+    if (!file) {
+        return !failed;
+    }
+
+    compress(true);
+    deflateEnd(&state->stream);
+
+    if (std::fclose(file) != 0) {
+        failed = true;
+    }
+    file = nullptr;
+
+    return !failed;
+}
+
+#else
+
+std::unique_ptr<llvm::MemoryBuffer> decompressGzip(llvm::StringRef data, const std::string& name) {
+    throw std::invalid_argument("Error loading module - llvm2c is built without zlib, compressed input is not supported:\n" + name + "\n");
+}
+
+struct GzipFileBuffer::State { };
+
+GzipFileBuffer::GzipFileBuffer(const std::string& fileName) {
+    throw std::invalid_argument("llvm2c is built without zlib, compressed output is not supported!");
+}
+
+GzipFileBuffer::~GzipFileBuffer() { }
+
+bool GzipFileBuffer::compress(bool finish) {
+    return false;
+}
+
+int GzipFileBuffer::overflow(int c) {
+    return traits_type::eof();
+}
+
+int GzipFileBuffer::sync() {
+    return -1;
+}
+
+bool GzipFileBuffer::close() {
+    return false;
+}
+
+#endif
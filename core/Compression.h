@@ -0,0 +1,80 @@
+#pragma once
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/MemoryBuffer.h"
+
+#include <cstdio>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+/*
+ * Support for gzip compressed inputs and outputs. Compression is available only when llvm2c is built
+ * with zlib (HAVE_ZLIB), otherwise compressed files are reported as errors.
+ */
+
+/**
+ * @brief isGzip Checks whether the data start with the gzip magic number.
+ * @param data Content of a file
+ * @return True if the data are gzip compressed, false otherwise
+ */
+bool isGzip(llvm::StringRef data);
+
+/**
+ * @brief hasGzipExtension Checks whether the file name ends with ".gz".
+ * @param fileName Name of the file
+ * @return True if the file should be compressed, false otherwise
+ */
+bool hasGzipExtension(llvm::StringRef fileName);
+
+/**
+ * @brief decompressGzip Decompresses gzip data (possibly consisting of multiple members) into a new buffer.
+ * Bytes following the last member are ignored. Throws std::invalid_argument if the data are corrupted or llvm2c is built without zlib.
+ * @param data Compressed data
+ * @param name Identifier of the new buffer
+ * @return Null terminated buffer with decompressed data
+ */
+std::unique_ptr<llvm::MemoryBuffer> decompressGzip(llvm::StringRef data, const std::string& name);
+
+/**
+ * @brief The GzipFileBuffer class is a stream buffer compressing everything written into it to a gzip file,
+ * so the output does not need to be kept in memory or written uncompressed to the disk.
+ */
+class GzipFileBuffer : public std::streambuf {
+private:
+    struct State; //zlib stream, defined only with zlib
+
+    std::FILE* file = nullptr;
+    std::unique_ptr<State> state;
+    std::vector<char> input; //uncompressed data waiting for compression
+    std::vector<char> output; //compressed data waiting for write
+    bool failed = false; //compression or write failed
+
+    /**
+     * @brief compress Compresses the buffered input and writes the compressed data to the file.
+     * @param finish Finishes the gzip member
+     * @return True on success, false otherwise
+     */
+    bool compress(bool finish);
+
+protected:
+    int overflow(int c) override;
+    int sync() override;
+
+public:
+    /**
+     * @brief GzipFileBuffer Opens the file for compressed output.
+     * Throws std::invalid_argument if the file cannot be opened or llvm2c is built without zlib.
+     * @param fileName Name of the output file
+     */
+    GzipFileBuffer(const std::string& fileName);
+
+    ~GzipFileBuffer() override;
+
+    /**
+     * @brief close Finishes compression and closes the file.
+     * @return True if all data were compressed and written, false otherwise
+     */
+    bool close();
+};
@@ -0,0 +1,188 @@
+#include "ConstantHandler.h"
+
+#include "llvm/IR/GetElementPtrTypeIterator.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "Program.h"
+#include "../type/Type.h"
+#include "../expr/UnaryExpr.h"
+
+Expr* ConstantHandler::getExpr(const llvm::Constant* val) {
+    if (llvm::isa<llvm::GlobalVariable>(val)) {
+        return program->getGlobalVar(val);
+    }
+
+    auto it = constants.find(val);
+    if (it != constants.end()) {
+        return it->second.get();
+    }
+
+    auto expr = createConstant(val);
+    if (!expr) {
+        return nullptr;
+    }
+
+    Expr* ret = expr.get();
+    constants[val] = std::move(expr);
+    return ret;
+}
+
+Expr* ConstantHandler::getOperandExpr(const llvm::Constant* val) {
+    Expr* expr = getExpr(val);
+    if (!expr) {
+        std::string constant;
+        llvm::raw_string_ostream stream(constant);
+        val->print(stream);
+        throw std::invalid_argument("Unsupported constant in constant expression:\n" + stream.str() + "\n");
+    }
+
+    return expr;
+}
+
+std::unique_ptr<Expr> ConstantHandler::createConstant(const llvm::Constant* val) {
+    if (auto F = llvm::dyn_cast<llvm::Function>(val)) {
+        return std::make_unique<Value>("&" + F->getName().str(), program->getType(F->getReturnType()));
+    }
+
+    //aggregate constants are translated as compound literals
+    if (val->getType()->isStructTy() || val->getType()->isArrayTy()) {
+        auto type = program->getType(val->getType());
+        std::string literal = "(" + type->toString();
+        if (auto AT = llvm::dyn_cast<ArrayType>(type.get())) {
+            literal += AT->sizeToString();
+        }
+        //string literals have to be enclosed in braces in compound literals
+        std::string init = program->getInitValue(val);
+        if (init[0] != '{') {
+            init = "{" + init + "}";
+        }
+        literal += ")" + init;
+
+        auto value = std::make_unique<Value>(literal, std::move(type));
+        value->init = true;
+        return value;
+    }
+
+    //undefined value is translated as zero, only for experimental purposes (this value cannot occur in LLVM generated from C)
+    if (llvm::isa<llvm::UndefValue>(val)) {
+        return std::make_unique<Value>("0", program->getType(val->getType()));
+    }
+
+    if (auto CPN = llvm::dyn_cast<llvm::ConstantPointerNull>(val)) {
+        return std::make_unique<Value>("0", program->getType(CPN->getType()));
+    }
+
+    if (auto CI = llvm::dyn_cast<llvm::ConstantInt>(val)) {
+        return std::make_unique<Value>(getIntegerValue(CI->getValue()), std::make_unique<IntType>(false));
+    }
+
+    if (auto CFP = llvm::dyn_cast<llvm::ConstantFP>(val)) {
+        return std::make_unique<Value>(getFloatValue(CFP->getValueAPF()), std::make_unique<FloatType>());
+    }
+
+    if (auto CE = llvm::dyn_cast<llvm::ConstantExpr>(val)) {
+        return createConstantExpr(CE);
+    }
+
+    return nullptr;
+}
+
+std::unique_ptr<Expr> ConstantHandler::createConstantExpr(const llvm::ConstantExpr* CE) {
+    if (CE->getOpcode() == llvm::Instruction::GetElementPtr) {
+        return createGepExpr(CE);
+    }
+
+    if (CE->isCast()) {
+        auto cast = std::make_unique<CastExpr>(getOperandExpr(CE->getOperand(0)), program->getType(CE->getType()));
+        if (CE->getOpcode() == llvm::Instruction::FPToUI) {
+            static_cast<IntegerType*>(cast->getType())->unsignedType = true;
+        }
+        return cast;
+    }
+
+    if (CE->isCompare()) {
+        return Block::createCmpExpr(static_cast<llvm::CmpInst::Predicate>(CE->getPredicate()), getOperandExpr(CE->getOperand(0)), getOperandExpr(CE->getOperand(1)));
+    }
+
+    if (CE->getOpcode() == llvm::Instruction::Select) {
+        return std::make_unique<SelectExpr>(getOperandExpr(CE->getOperand(0)), getOperandExpr(CE->getOperand(1)), getOperandExpr(CE->getOperand(2)));
+    }
+
+    if (llvm::Instruction::isBinaryOp(CE->getOpcode())) {
+        return Block::createBinaryExpr(CE->getOpcode(), getOperandExpr(CE->getOperand(0)), getOperandExpr(CE->getOperand(1)));
+    }
+
+    return nullptr;
+}
+
+std::unique_ptr<Expr> ConstantHandler::createGepExpr(const llvm::ConstantExpr* CE) {
+    Expr* expr = getOperandExpr(CE->getOperand(0));
+
+    llvm::Type* prevType = CE->getOperand(0)->getType();
+    Expr* prevExpr = expr;
+    std::vector<std::unique_ptr<Expr>> indices;
+
+    //if getelementptr contains null, cast it to given type
+    if (expr->toString().compare("0") == 0) {
+        exprs.push_back(std::make_unique<CastExpr>(expr, program->getType(prevType)));
+        prevExpr = exprs[exprs.size() - 1].get();
+    }
+
+    for (auto it = llvm::gep_type_begin(CE); it != llvm::gep_type_end(CE); it++) {
+        Expr* index = getOperandExpr(llvm::cast<llvm::Constant>(it.getOperand()));
+
+        if (prevType->isPointerTy()) {
+            if (index->toString().compare("0") == 0) {
+                indices.push_back(std::make_unique<DerefExpr>(prevExpr));
+            } else {
+                indices.push_back(std::make_unique<PointerShift>(program->getType(prevType), prevExpr, index));
+            }
+        }
+
+        if (prevType->isArrayTy()) {
+            indices.push_back(std::make_unique<ArrayElement>(prevExpr, index, program->getType(prevType->getArrayElementType())));
+        }
+
+        if (prevType->isStructTy()) {
+            llvm::ConstantInt* CI = llvm::dyn_cast<llvm::ConstantInt>(it.getOperand());
+            if (!CI) {
+                throw std::invalid_argument("Invalid GEP index - access to struct element only allows integer!");
+            }
+
+            indices.push_back(std::make_unique<StructElement>(program->getStruct(llvm::cast<llvm::StructType>(prevType)), prevExpr, CI->getSExtValue()));
+        }
+
+        prevType = it.getIndexedType();
+        prevExpr = indices[indices.size() - 1].get();
+    }
+
+    exprs.push_back(std::make_unique<GepExpr>(indices));
+    return std::make_unique<RefExpr>(exprs[exprs.size() - 1].get());
+}
+
+std::string ConstantHandler::getIntegerValue(const llvm::APInt& value) {
+    if (value.getBitWidth() > 64) {
+        return std::to_string(value.getLimitedValue());
+    }
+
+    if (value.getBitWidth() == 1) { //bool in LLVM
+        return std::to_string(-1 * value.getSExtValue());
+    }
+
+    return std::to_string(value.getSExtValue());
+}
+
+std::string ConstantHandler::getFloatValue(const llvm::APFloat& value) {
+    if (value.isInfinity()) {
+        return value.isNegative() ? "-(__builtin_inff ())" : "__builtin_inff ()";
+    }
+
+    if (value.isNaN()) {
+        return value.isNegative() ? "-(__builtin_nanf (\"\"))" : "__builtin_nanf (\"\")";
+    }
+
+    llvm::SmallVector<char, 32> string;
+    value.toString(string, 32, 0);
+    return std::string(string.begin(), string.end());
+}
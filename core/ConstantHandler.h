@@ -0,0 +1,76 @@
+#pragma once
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/IR/Constants.h"
+
+#include "../expr/Expr.h"
+
+#include <memory>
+#include <vector>
+
+class Program;
+
+/**
+ * @brief The ConstantHandler class translates LLVM constants used as operands of instructions.
+ * Translated constants (including constant expressions) are cached and shared by all functions of the program.
+ */
+class ConstantHandler {
+private:
+    Program* program;
+    llvm::DenseMap<const llvm::Constant*, std::unique_ptr<Expr>> constants; //map containing translated constants
+    std::vector<std::unique_ptr<Expr>> exprs; //vector of expressions used inside translated constant expressions (e.g. getelementptr indices)
+
+    /**
+     * @brief createConstant Translates given constant into new expression.
+     * @param val LLVM Constant
+     * @return Translated expression, nullptr if the constant is not supported
+     */
+    std::unique_ptr<Expr> createConstant(const llvm::Constant* val);
+
+    /**
+     * @brief getOperandExpr Returns expression of an operand of a constant expression.
+     * Throws std::invalid_argument if the operand is not supported.
+     * @param val LLVM Constant
+     * @return Pointer to the expression
+     */
+    Expr* getOperandExpr(const llvm::Constant* val);
+
+    /**
+     * @brief createConstantExpr Translates given constant expression directly, without creating corresponding instruction.
+     * @param CE LLVM ConstantExpr
+     * @return Translated expression, nullptr if the constant expression is not supported
+     */
+    std::unique_ptr<Expr> createConstantExpr(const llvm::ConstantExpr* CE);
+
+    /**
+     * @brief createGepExpr Translates getelementptr constant expression.
+     * @param CE LLVM ConstantExpr with GetElementPtr opcode
+     * @return RefExpr of the indexed element
+     */
+    std::unique_ptr<Expr> createGepExpr(const llvm::ConstantExpr* CE);
+
+public:
+    ConstantHandler(Program* program)
+        : program(program) { }
+
+    /**
+     * @brief getExpr Returns expression corresponding to the given constant, translates the constant if it has not been translated yet.
+     * @param val LLVM Constant
+     * @return Pointer to the expression, nullptr if the constant is not supported
+     */
+    Expr* getExpr(const llvm::Constant* val);
+
+    /**
+     * @brief getIntegerValue Returns string containing C literal of given integer constant.
+     * @param value LLVM APInt
+     * @return String containing the integer value
+     */
+    static std::string getIntegerValue(const llvm::APInt& value);
+
+    /**
+     * @brief getFloatValue Returns string containing C expression of given floating point constant.
+     * @param value LLVM APFloat
+     * @return String containing the floating point value
+     */
+    static std::string getFloatValue(const llvm::APFloat& value);
+};
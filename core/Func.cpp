@@ -4,66 +4,51 @@
 #include <llvm/IR/Metadata.h>
 #include <llvm/Support/raw_ostream.h>
 
+#include "MemoryReport.h"
+#include "Trace.h"
 #include "../type/Type.h"
 
 #include <utility>
+#include <chrono>
 #include <cstdint>
 #include <string>
 #include <fstream>
-#include <set>
-#include <regex>
-
-const static std::set<std::string> STDLIB_FUNCTIONS = {"atof", "atoi", "atol", "strtod", "strtol", "strtoul", "calloc",
-                                                       "free", "malloc", "realloc", "abort", "atexit", "exit", "getenv",
-                                                       "system", "bsearch", "qsort", "abs", "div", "labs", "ldiv",
-                                                       "rand", "srand", "mblen", "mbstowcs", "mbtowc", "wcstombs", "wctomb",
-                                                       "strtoll", "strtoull", "realpath"};
-
-const static std::set<std::string> STRING_FUNCTIONS = {"memchr", "memcmp", "memcpy", "memmove", "memset", "strcat", "strncat",
-                                                       "strchr", "strcmp", "strncmp", "strcoll", "strcpy", "strncpy", "strcspn",
-                                                       "strerror", "strlen", "strpbrk", "strrchr", "strspn", "strstr", "strtok",
-                                                       "strxfrm", "strsep", "strnlen", "strncasecmp", "strcasecmp", "stpcpy",
-                                                       "strdup"};
-
-const static std::set<std::string> STDIO_FUNCTIONS = {"fclose", "clearerr", "feof", "ferror", "fflush", "fgetpos", "fopen",
-                                                      "fread", "freopen", "fseek", "fsetpos", "ftell", "fwrite", "remove",
-                                                      "rename", "rewind", "setbuf", "setvbuf", "tmpfile", "tmpnam", "fprintf",
-                                                      "sprintf", "vfprintf", "vsprintf", "fscanf", "scanf", "sscanf", "fgetc",
-                                                      "fgets", "fputc", "fputs", "getc", "getchar", "gets", "putc", "putchar",
-                                                      "puts", "ungetc", "perror", "snprintf", "vsnprintf", "printf", "pclose",
-                                                      "popen", "fileno", "fseeko"};
-
-const static std::set<std::string> PTHREAD_FUNCTIONS = {"pthread_attr_destroy", "pthread_attr_getdetachstate", "pthread_attr_getguardsize",
-                                                        "pthread_attr_getinheritsched", "pthread_attr_getschedparam", "pthread_attr_getschedpolicy",
-                                                        "pthread_attr_getscope", "pthread_attr_getstackaddr", "pthread_attr_getstacksize",
-                                                        "pthread_attr_init", "pthread_attr_setdetachstate", "pthread_attr_setguardsize",
-                                                        "pthread_attr_setinheritsched", "pthread_attr_setschedparam", "pthread_attr_setschedpolicy",
-                                                        "pthread_attr_setscope", "pthread_attr_setstackaddr", "pthread_attr_setstacksize",
-                                                        "pthread_cancel", "pthread_cleanup_push", "pthread_cleanup_pop", "pthread_cond_broadcast",
-                                                        "pthread_cond_destroy", "pthread_cond_init", "pthread_cond_signal", "pthread_cond_timedwait",
-                                                        "pthread_cond_wait", "pthread_condattr_destroy", "pthread_condattr_getpshared",
-                                                        "pthread_condattr_init", "pthread_condattr_setpshared","pthread_create",  "pthread_detach",
-                                                        "pthread_equal", "pthread_exit", "pthread_getconcurrency", "pthread_getschedparam","pthread_getspecific",
-                                                        "pthread_join", "pthread_key_create", "pthread_key_delete", "pthread_mutex_destroy",
-                                                        "pthread_mutex_getprioceiling", "pthread_mutex_init", "pthread_mutex_lock",
-                                                        "pthread_mutex_setprioceiling", "pthread_mutex_trylock", "pthread_mutex_unlock",
-                                                        "pthread_mutexattr_destroy", "pthread_mutexattr_getprioceiling", "pthread_mutexattr_getprotocol",
-                                                        "pthread_mutexattr_getpshared", "pthread_mutexattr_gettype", "pthread_mutexattr_init",
-                                                        "pthread_mutexattr_setprioceiling", "pthread_mutexattr_setprotocol", "pthread_mutexattr_setpshared",
-                                                        "pthread_mutexattr_settype", "pthread_once","pthread_rwlock_destroy", "pthread_rwlock_init",
-                                                        "pthread_rwlock_rdlock", "pthread_rwlock_tryrdlock", "pthread_rwlock_trywrlock",
-                                                        "pthread_rwlock_unlock", "pthread_rwlock_wrlock","pthread_rwlockattr_destroy",
-                                                        "pthread_rwlockattr_getpshared", "pthread_rwlockattr_init", "pthread_rwlockattr_setpshared",
-                                                        "pthread_self","pthread_setcancelstate",  "pthread_setcanceltype", "pthread_setconcurrency",
-                                                        "pthread_setschedparam", "pthread_setspecific", "pthread_testcancel"};
-
-Func::Func(const llvm::Function* func, Program* program, bool isDeclaration) {
+
+Func::Func(const llvm::Function* func, Program* program, bool isDeclaration)
+    : names(&program->globalNames) {
+    MemoryReport::Scope memoryScope(MemoryReport::FUNC);
+
     this->program = program;
     function = func;
     this->isDeclaration = isDeclaration;
     returnType = getType(func->getReturnType());
 
-    parseFunction();
+    const llvm::Value* larg = nullptr;
+
+    std::string name = function->getName().str();
+    if (Block::isCFunc(Block::getCFunc(name))) {
+        name = Block::getCFunc(name);
+        if (Block::isCMath(name)) {
+            name = Block::getCMathFunc(name, func->getReturnType());
+        }
+    }
+
+    libcFunction = isDeclaration ? getLibcFunction(name) : nullptr;
+    if (program->includes && libcFunction) {
+        program->libcHeaders |= 1u << static_cast<unsigned>(libcFunction->header);
+    }
+
+    getMetadataNames();
+
+    for (const llvm::Value& arg : function->args()) {
+        exprMap[&arg] = std::make_unique<Value>(getVarName(), getType(arg.getType()));
+        larg = &arg;
+    }
+
+    lastArg = exprMap[larg].get();
+    if (lastArg) {
+        isVarArg = function->isVarArg();
+    }
 }
 
 std::string Func::getBlockName(const llvm::BasicBlock* block) {
@@ -81,16 +66,17 @@ std::string Func::getBlockName(const llvm::BasicBlock* block) {
 }
 
 Expr* Func::getExpr(const llvm::Value* val) {
-    if (exprMap.find(val) == exprMap.end()) {
-        if (auto F = llvm::dyn_cast<llvm::Function>(val)) {
-            createExpr(val, std::make_unique<Value>("&" + F->getName().str(), getType(F->getReturnType())));
-            return exprMap.find(val)->second.get();
-        }
-    } else {
-        return exprMap.find(val)->second.get();
+    auto iter = exprMap.find(val);
+    if (iter != exprMap.end()) {
+        return iter->second.get();
     }
 
-    return program->getGlobalVar(val);
+    //constants (including functions) are shared by all functions of the program
+    if (auto C = llvm::dyn_cast<llvm::Constant>(val)) {
+        return program->constantHandler.getExpr(C);
+    }
+
+    return nullptr;
 }
 
 void Func::createExpr(const llvm::Value* val, std::unique_ptr<Expr> expr) {
@@ -98,53 +84,22 @@ void Func::createExpr(const llvm::Value* val, std::unique_ptr<Expr> expr) {
 }
 
 std::string Func::getVarName() {
-    std::string varName = "var";
-    while (metadataVarNames.count(varName + std::to_string(varCount))) {
-        varCount++;
-    }
-    varName += std::to_string(varCount);
-    varCount++;
-
-    return varName;
+    return names.getVarName();
 }
 
 void Func::parseFunction() {
-    const llvm::Value* larg;
-
-    std::string name = function->getName().str();
-    if (Block::isCFunc(Block::getCFunc(name))) {
-        name = Block::getCFunc(name);
-    }
-
-    if (program->includes) {
-        if (isStdLibFunc(name)) {
-            program->hasStdLib = true;
-        }
-
-        if (isStringFunc(name)) {
-            program->hasString = true;
-        }
-
-        if (isStdioFunc(name)) {
-            program->hasStdio = true;
-        }
-
-        if (isPthreadFunc(name)) {
-            program->hasPthread = true;
-        }
+    //declarations have no blocks, definitions are parsed only once
+    if (isDeclaration || isParsed) {
+        return;
     }
+    isParsed = true;
 
-    getMetadataNames();
+    MemoryReport::Scope memoryScope(MemoryReport::FUNC);
+    Trace::Span span("parseFunction", function->getName());
 
-    for (const llvm::Value& arg : function->args()) {
-        exprMap[&arg] = std::make_unique<Value>(getVarName(), getType(arg.getType()));
-        larg = &arg;
-    }
-
-    lastArg = exprMap[larg].get();
-    if (lastArg) {
-        isVarArg = function->isVarArg();
-    }
+    auto start = std::chrono::steady_clock::now();
+    std::size_t exprs = MemoryReport::getAllocationCount(MemoryReport::EXPR);
+    unsigned vars = names.getCount();
 
     for (const auto& block : *function) {
         getBlockName(&block);
@@ -153,11 +108,13 @@ void Func::parseFunction() {
     for (const auto& block : *function) {
         blockMap[&block]->parseLLVMBlock();
     }
+
+    parseTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    exprCount = MemoryReport::getAllocationCount(MemoryReport::EXPR) - exprs;
+    temporaryCount = names.getCount() - vars;
 }
 
 void Func::getMetadataNames() {
-    metadataVarNames.insert(program->globalVarNames.begin(), program->globalVarNames.end());
-
     for (const llvm::BasicBlock& block : *function) {
         for (const llvm::Instruction& ins : block) {
             if (ins.getOpcode() == llvm::Instruction::Call) {
@@ -166,10 +123,7 @@ void Func::getMetadataNames() {
                     llvm::Metadata* varMD = llvm::dyn_cast<llvm::MetadataAsValue>(ins.getOperand(1))->getMetadata();
                     llvm::DILocalVariable* localVar = llvm::dyn_cast<llvm::DILocalVariable>(varMD);
 
-                    std::regex varName("var[0-9]+");
-                    if (std::regex_match(localVar->getName().str(), varName)) {
-                        metadataVarNames.insert(localVar->getName().str());
-                    }
+                    names.reserve(localVar->getName());
                 }
             }
         }
@@ -183,22 +137,34 @@ void Func::output(std::ostream& stream) {
         name = Block::getCFunc(name);
         if (name.compare("va_start") == 0
                 || name.compare("va_end") == 0
-                || name.compare("va_copy") == 0
-                || Block::isCMath(name)) {
+                || name.compare("va_copy") == 0) {
             return;
         }
 
-    }
-
-    if (program->includes) {
-        if (isStdLibFunc(name) || isStringFunc(name) || isStdioFunc(name) || isPthreadFunc(name)) {
+        //math intrinsics are called by names of C functions, which are declared only if their prototype fits the intrinsic
+        if (Block::isCMath(name) && (!libcFunction || !hasCompatibleSignature(*libcFunction, function->getFunctionType(), program->module->getDataLayout()))) {
             return;
         }
-    } else {
-        //sometimes LLVM uses these functions with more arguments than their C counterparts
-        if ((name.compare("memcpy") == 0 || name.compare("memset") == 0 || name.compare("memmove") == 0) && function->arg_size() > 3) {
-            return;
+
+    }
+
+    if (program->includes && libcFunction) {
+        return;
+    }
+
+    //sometimes LLVM uses these functions with more arguments than their C counterparts
+    if ((name.compare("memcpy") == 0 || name.compare("memset") == 0 || name.compare("memmove") == 0) && function->arg_size() > 3) {
+        return;
+    }
+
+    //canonical prototypes keep the functions builtins of the C compiler, they are not used when the address of the
+    //function is taken, because the pointer would have a different type than the one used by the module
+    if (libcFunction && !function->hasAddressTaken() && hasCompatibleSignature(*libcFunction, function->getFunctionType(), program->module->getDataLayout())) {
+        //overloads of an intrinsic or the intrinsic together with the C function share the prototype
+        if (program->declaredLibcFunctions.insert(libcFunction).second) {
+            stream << libcFunction->signature << ";\n";
         }
+        return;
     }
 
     if (name.substr(0, 4).compare("llvm") == 0) {
@@ -206,7 +172,7 @@ void Func::output(std::ostream& stream) {
     }
 
     stream << returnType->toString();
-    auto PT = dynamic_cast<PointerType*>(returnType.get());
+    auto PT = llvm::dyn_cast<PointerType>(returnType.get());
     if (PT && PT->isArrayPointer) {
         stream << " (";
         for (unsigned i = 0; i < PT->levels; i++) {
@@ -226,6 +192,7 @@ void Func::output(std::ostream& stream) {
         first = false;
 
         Value* val = static_cast<Value*>(exprMap.find(&arg)->second.get());
+        val->init = false;
         stream << val->getType()->toString();
         stream << " ";
         stream << val->toString();
@@ -247,6 +214,10 @@ void Func::output(std::ostream& stream) {
     }
 
     if (isDeclaration) {
+        //internal functions are referenced from other files when the program is split
+        if (program->splitOutput && function->hasInternalLinkage()) {
+            stream << " __attribute__((visibility(\"hidden\")))";
+        }
         stream << ";\n";
         return;
     }
@@ -278,7 +249,7 @@ RefExpr* Func::getGlobalVar(llvm::Value* val) const {
     return program->getGlobalVar(val);
 }
 
-void Func::addDeclaration(llvm::Function* func) {
+void Func::addDeclaration(const llvm::Function* func) {
     program->addDeclaration(func);
 }
 
@@ -290,24 +261,10 @@ void Func::createNewUnnamedStruct(const llvm::StructType* strct) {
     program->createNewUnnamedStruct(strct);
 }
 
-std::unique_ptr<Type> Func::getType(const llvm::Type* type) {
-    return program->getType(type);
-}
-
-bool Func::isStdLibFunc(const std::string& func) {
-    return STDLIB_FUNCTIONS.find(func) != STDLIB_FUNCTIONS.end();
-}
-
-bool Func::isStringFunc(const std::string& func) {
-    return STRING_FUNCTIONS.find(func) != STRING_FUNCTIONS.end();
-}
-
-bool Func::isStdioFunc(const std::string& func) {
-    return STDIO_FUNCTIONS.find(func) != STDIO_FUNCTIONS.end();
+const llvm::DataLayout& Func::getDataLayout() const {
+    return program->module->getDataLayout();
 }
 
-bool Func::isPthreadFunc(const std::string& func) {
-    return PTHREAD_FUNCTIONS.find(func) != PTHREAD_FUNCTIONS.end();
+std::unique_ptr<Type> Func::getType(const llvm::Type* type) {
+    return program->getType(type);
 }
-
-
@@ -5,6 +5,7 @@
 #include <set>
 
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/IR/DataLayout.h"
 
 class Program;
 
@@ -12,6 +13,8 @@ class Program;
 #include "../expr/UnaryExpr.h"
 #include "../expr/BinaryExpr.h"
 #include "Block.h"
+#include "NameService.h"
+#include "LibcTable.h"
 #include "Program.h"
 
 /**
@@ -29,16 +32,22 @@ private:
     llvm::DenseMap<const llvm::BasicBlock*, std::unique_ptr<Block>> blockMap; //DenseMap used for mapping llvm::BasicBlock to Block
     llvm::DenseMap<const llvm::Value*, std::unique_ptr<Expr>> exprMap; // DenseMap used for mapping llvm::Value to Expr
 
-    //set containing metadata names of variables (and names of global variables) that are in "var[0-9]+" format, used in creating variable names
-    std::set<std::string> metadataVarNames;
+    //creates names of variables, avoids names of variables from debug information and names of global variables
+    NameService names;
 
-    //variables used for creating names for variables and blocks
-    unsigned varCount = 0;
+    //variable used for creating names for blocks
     unsigned blockCount = 0;
 
 
     bool isDeclaration; //function is only being declared
     bool isVarArg = false; //function has variable number of arguments
+    bool isParsed = false; //blocks of the function are already parsed
+    const LibcFunction* libcFunction; //known library function with the same name, only for declarations
+
+    //costs of parsing, used in cost report
+    double parseTime = 0; //time of parsing in seconds
+    std::size_t exprCount = 0; //number of Expr nodes created by parsing
+    unsigned temporaryCount = 0; //number of variables created by parsing
 
     Expr* lastArg; //last argument before variable arguments
 
@@ -52,7 +61,7 @@ private:
     std::string getBlockName(const llvm::BasicBlock* block); //RENAME
 
     /**
-     * @brief getExpr Finds Expr in exprMap or globalRefs with key val. If val is function, creates Value containing refference to the function and returns pointer to this Value.
+     * @brief getExpr Finds Expr in exprMap with key val. If val is function, creates Value containing refference to the function and returns pointer to this Value. Other constants are translated by the program's ConstantHandler.
      * @param val Key of the Expr
      * @return Pointer to the Expr if val is found, nullptr otherwise.
      */
@@ -78,41 +87,13 @@ private:
     void createNewUnnamedStruct(const llvm::StructType* strct);
 
     /**
-     * @brief isStdLibFunc Checks whether the function is part of stdlib.h
-     * @param func Function name
-     * @return True if function is part of stdlib.h, false otherwise
-     */
-    bool isStdLibFunc(const std::string& func);
-
-    /**
-     * @brief isStringFunc Checks whether the function is part of string.h
-     * @param func Function name
-     * @return True if function is part of string.h, false otherwise
-     */
-    bool isStringFunc(const std::string& func);
-
-    /**
-     * @brief isStdioFunc Checks whether the function is part of stdio.h
-     * @param func Function name
-     * @return True if function is part of stdio.h, false otherwise
-     */
-    bool isStdioFunc(const std::string& func);
-
-    /**
-     * @brief isPthreadFunc Checks whether the function is part of pthread.h
-     * @param func Function name
-     * @return True if function is part of pthread.h, false otherwise
-     */
-    bool isPthreadFunc(const std::string& func);
-
-    /**
-     * @brief getMetadataNames Parses variable medatada in function and saves the variable names into the metadataVarNames set.
+     * @brief getMetadataNames Parses variable medatada in function and reserves the variable names, so they are not used for created variables.
      */
     void getMetadataNames();
 
 public:
     /**
-     * @brief Func Constructor for Func.
+     * @brief Func Constructor for Func. Parses arguments of the function, blocks are parsed by parseFunction.
      * @param func llvm::Function for parsing
      * @param program Program to which function belongs
      * @param isDeclaration function is only being declared
@@ -120,7 +101,7 @@ public:
     Func(const llvm::Function* func, Program* program, bool isDeclaration);
 
     /**
-     * @brief parseFunction Parses blocks of the llvm::Function.
+     * @brief parseFunction Parses blocks of the llvm::Function. Does nothing for declarations and already parsed functions.
      */
     void parseFunction();
 
@@ -155,13 +136,19 @@ public:
      * @brief addDeclaration Adds new declaration of given function.
      * @param func LLVM Function
      */
-    void addDeclaration(llvm::Function* func);
+    void addDeclaration(const llvm::Function* func);
 
     /**
      * @brief stackIgnored Indicated that intrinsic stacksave/stackrestore was ignored.
      */
     void stackIgnored();
 
+    /**
+     * @brief getDataLayout Returns DataLayout of the module containing the function.
+     * @return LLVM DataLayout
+     */
+    const llvm::DataLayout& getDataLayout() const;
+
     /**
      * @brief getType Transforms llvm::Type into corresponding Type object
      * @param type llvm::Type for transformation
@@ -0,0 +1,529 @@
+#include "LibcTable.h"
+
+#include <cstddef>
+#include <cstring>
+
+using H = LibcHeader;
+
+//size_t is spelled as __SIZE_TYPE__, so the signatures do not need any header
+constexpr static LibcFunction LIBC_FUNCTIONS[] = {
+    //stdlib.h
+    {"atof", H::STDLIB, "double atof(const char*)", "dp"},
+    {"atoi", H::STDLIB, "int atoi(const char*)", "ip"},
+    {"atol", H::STDLIB, "long atol(const char*)", "np"},
+    {"atoll", H::STDLIB, "long long atoll(const char*)", "qp"},
+    {"strtod", H::STDLIB, "double strtod(const char*, char**)", "dpp"},
+    {"strtof", H::STDLIB, "float strtof(const char*, char**)", "fpp"},
+    {"strtol", H::STDLIB, "long strtol(const char*, char**, int)", "nppi"},
+    {"strtoul", H::STDLIB, "unsigned long strtoul(const char*, char**, int)", "nppi"},
+    {"strtoll", H::STDLIB, "long long strtoll(const char*, char**, int)", "qppi"},
+    {"strtoull", H::STDLIB, "unsigned long long strtoull(const char*, char**, int)", "qppi"},
+    {"calloc", H::STDLIB, "void* calloc(__SIZE_TYPE__, __SIZE_TYPE__)", "pnn"},
+    {"free", H::STDLIB, "void free(void*)", "vp"},
+    {"malloc", H::STDLIB, "void* malloc(__SIZE_TYPE__)", "pn"},
+    {"realloc", H::STDLIB, "void* realloc(void*, __SIZE_TYPE__)", "ppn"},
+    {"posix_memalign", H::STDLIB, nullptr, nullptr},
+    {"abort", H::STDLIB, "void abort(void)", "v"},
+    {"atexit", H::STDLIB, "int atexit(void (*)(void))", "ip"},
+    {"exit", H::STDLIB, "void exit(int)", "vi"},
+    {"_Exit", H::STDLIB, "void _Exit(int)", "vi"},
+    {"getenv", H::STDLIB, "char* getenv(const char*)", "pp"},
+    {"setenv", H::STDLIB, "int setenv(const char*, const char*, int)", "ippi"},
+    {"unsetenv", H::STDLIB, "int unsetenv(const char*)", "ip"},
+    {"system", H::STDLIB, "int system(const char*)", "ip"},
+    {"bsearch", H::STDLIB, nullptr, nullptr},
+    {"qsort", H::STDLIB, nullptr, nullptr},
+    {"abs", H::STDLIB, "int abs(int)", "ii"},
+    {"labs", H::STDLIB, "long labs(long)", "nn"},
+    {"llabs", H::STDLIB, "long long llabs(long long)", "qq"},
+    {"div", H::STDLIB, nullptr, nullptr},
+    {"ldiv", H::STDLIB, nullptr, nullptr},
+    {"rand", H::STDLIB, "int rand(void)", "i"},
+    {"srand", H::STDLIB, "void srand(unsigned int)", "vi"},
+    {"mblen", H::STDLIB, "int mblen(const char*, __SIZE_TYPE__)", "ipn"},
+    {"mbstowcs", H::STDLIB, nullptr, nullptr},
+    {"mbtowc", H::STDLIB, nullptr, nullptr},
+    {"wcstombs", H::STDLIB, nullptr, nullptr},
+    {"wctomb", H::STDLIB, nullptr, nullptr},
+    {"mkstemp", H::STDLIB, "int mkstemp(char*)", "ip"},
+    {"realpath", H::STDLIB, "char* realpath(const char*, char*)", "ppp"},
+
+    //string.h
+    {"memchr", H::STRING, "void* memchr(const void*, int, __SIZE_TYPE__)", "ppin"},
+    {"memcmp", H::STRING, "int memcmp(const void*, const void*, __SIZE_TYPE__)", "ippn"},
+    {"memcpy", H::STRING, "void* memcpy(void*, const void*, __SIZE_TYPE__)", "pppn"},
+    {"memmove", H::STRING, "void* memmove(void*, const void*, __SIZE_TYPE__)", "pppn"},
+    {"memset", H::STRING, "void* memset(void*, int, __SIZE_TYPE__)", "ppin"},
+    {"strcat", H::STRING, "char* strcat(char*, const char*)", "ppp"},
+    {"strncat", H::STRING, "char* strncat(char*, const char*, __SIZE_TYPE__)", "pppn"},
+    {"strchr", H::STRING, "char* strchr(const char*, int)", "ppi"},
+    {"strrchr", H::STRING, "char* strrchr(const char*, int)", "ppi"},
+    {"strcmp", H::STRING, "int strcmp(const char*, const char*)", "ipp"},
+    {"strncmp", H::STRING, "int strncmp(const char*, const char*, __SIZE_TYPE__)", "ippn"},
+    {"strcoll", H::STRING, "int strcoll(const char*, const char*)", "ipp"},
+    {"strcpy", H::STRING, "char* strcpy(char*, const char*)", "ppp"},
+    {"strncpy", H::STRING, "char* strncpy(char*, const char*, __SIZE_TYPE__)", "pppn"},
+    {"stpcpy", H::STRING, "char* stpcpy(char*, const char*)", "ppp"},
+    {"strcspn", H::STRING, "__SIZE_TYPE__ strcspn(const char*, const char*)", "npp"},
+    {"strspn", H::STRING, "__SIZE_TYPE__ strspn(const char*, const char*)", "npp"},
+    {"strerror", H::STRING, "char* strerror(int)", "pi"},
+    {"strlen", H::STRING, "__SIZE_TYPE__ strlen(const char*)", "np"},
+    {"strnlen", H::STRING, "__SIZE_TYPE__ strnlen(const char*, __SIZE_TYPE__)", "npn"},
+    {"strpbrk", H::STRING, "char* strpbrk(const char*, const char*)", "ppp"},
+    {"strstr", H::STRING, "char* strstr(const char*, const char*)", "ppp"},
+    {"strtok", H::STRING, "char* strtok(char*, const char*)", "ppp"},
+    {"strxfrm", H::STRING, "__SIZE_TYPE__ strxfrm(char*, const char*, __SIZE_TYPE__)", "nppn"},
+    {"strsep", H::STRING, "char* strsep(char**, const char*)", "ppp"},
+    {"strdup", H::STRING, "char* strdup(const char*)", "pp"},
+    {"strndup", H::STRING, "char* strndup(const char*, __SIZE_TYPE__)", "ppn"},
+
+    //strings.h
+    {"strcasecmp", H::STRINGS, "int strcasecmp(const char*, const char*)", "ipp"},
+    {"strncasecmp", H::STRINGS, "int strncasecmp(const char*, const char*, __SIZE_TYPE__)", "ippn"},
+
+    //stdio.h, functions with FILE or va_list keep the types from the module
+    {"fclose", H::STDIO, nullptr, nullptr},
+    {"clearerr", H::STDIO, nullptr, nullptr},
+    {"feof", H::STDIO, nullptr, nullptr},
+    {"ferror", H::STDIO, nullptr, nullptr},
+    {"fflush", H::STDIO, nullptr, nullptr},
+    {"fgetpos", H::STDIO, nullptr, nullptr},
+    {"fopen", H::STDIO, nullptr, nullptr},
+    {"fdopen", H::STDIO, nullptr, nullptr},
+    {"fread", H::STDIO, nullptr, nullptr},
+    {"freopen", H::STDIO, nullptr, nullptr},
+    {"fseek", H::STDIO, nullptr, nullptr},
+    {"fseeko", H::STDIO, nullptr, nullptr},
+    {"fsetpos", H::STDIO, nullptr, nullptr},
+    {"ftell", H::STDIO, nullptr, nullptr},
+    {"fwrite", H::STDIO, nullptr, nullptr},
+    {"remove", H::STDIO, "int remove(const char*)", "ip"},
+    {"rename", H::STDIO, "int rename(const char*, const char*)", "ipp"},
+    {"rewind", H::STDIO, nullptr, nullptr},
+    {"setbuf", H::STDIO, nullptr, nullptr},
+    {"setvbuf", H::STDIO, nullptr, nullptr},
+    {"tmpfile", H::STDIO, nullptr, nullptr},
+    {"tmpnam", H::STDIO, "char* tmpnam(char*)", "pp"},
+    {"fprintf", H::STDIO, nullptr, nullptr},
+    {"printf", H::STDIO, "int printf(const char*, ...)", "ip"},
+    {"sprintf", H::STDIO, "int sprintf(char*, const char*, ...)", "ipp"},
+    {"snprintf", H::STDIO, "int snprintf(char*, __SIZE_TYPE__, const char*, ...)", "ipnp"},
+    {"vfprintf", H::STDIO, nullptr, nullptr},
+    {"vprintf", H::STDIO, nullptr, nullptr},
+    {"vsprintf", H::STDIO, nullptr, nullptr},
+    {"vsnprintf", H::STDIO, nullptr, nullptr},
+    {"fscanf", H::STDIO, nullptr, nullptr},
+    {"scanf", H::STDIO, "int scanf(const char*, ...)", "ip"},
+    {"sscanf", H::STDIO, "int sscanf(const char*, const char*, ...)", "ipp"},
+    {"fgetc", H::STDIO, nullptr, nullptr},
+    {"fgets", H::STDIO, nullptr, nullptr},
+    {"fputc", H::STDIO, nullptr, nullptr},
+    {"fputs", H::STDIO, nullptr, nullptr},
+    {"getc", H::STDIO, nullptr, nullptr},
+    {"getchar", H::STDIO, "int getchar(void)", "i"},
+    {"gets", H::STDIO, "char* gets(char*)", "pp"},
+    {"putc", H::STDIO, nullptr, nullptr},
+    {"putchar", H::STDIO, "int putchar(int)", "ii"},
+    {"puts", H::STDIO, "int puts(const char*)", "ip"},
+    {"ungetc", H::STDIO, nullptr, nullptr},
+    {"perror", H::STDIO, "void perror(const char*)", "vp"},
+    {"popen", H::STDIO, nullptr, nullptr},
+    {"pclose", H::STDIO, nullptr, nullptr},
+    {"fileno", H::STDIO, nullptr, nullptr},
+
+    //pthread.h, all functions use types from the header
+    {"pthread_attr_destroy", H::PTHREAD, nullptr, nullptr},
+    {"pthread_attr_getdetachstate", H::PTHREAD, nullptr, nullptr},
+    {"pthread_attr_getguardsize", H::PTHREAD, nullptr, nullptr},
+    {"pthread_attr_getinheritsched", H::PTHREAD, nullptr, nullptr},
+    {"pthread_attr_getschedparam", H::PTHREAD, nullptr, nullptr},
+    {"pthread_attr_getschedpolicy", H::PTHREAD, nullptr, nullptr},
+    {"pthread_attr_getscope", H::PTHREAD, nullptr, nullptr},
+    {"pthread_attr_getstackaddr", H::PTHREAD, nullptr, nullptr},
+    {"pthread_attr_getstacksize", H::PTHREAD, nullptr, nullptr},
+    {"pthread_attr_init", H::PTHREAD, nullptr, nullptr},
+    {"pthread_attr_setdetachstate", H::PTHREAD, nullptr, nullptr},
+    {"pthread_attr_setguardsize", H::PTHREAD, nullptr, nullptr},
+    {"pthread_attr_setinheritsched", H::PTHREAD, nullptr, nullptr},
+    {"pthread_attr_setschedparam", H::PTHREAD, nullptr, nullptr},
+    {"pthread_attr_setschedpolicy", H::PTHREAD, nullptr, nullptr},
+    {"pthread_attr_setscope", H::PTHREAD, nullptr, nullptr},
+    {"pthread_attr_setstackaddr", H::PTHREAD, nullptr, nullptr},
+    {"pthread_attr_setstacksize", H::PTHREAD, nullptr, nullptr},
+    {"pthread_cancel", H::PTHREAD, nullptr, nullptr},
+    {"pthread_cleanup_push", H::PTHREAD, nullptr, nullptr},
+    {"pthread_cleanup_pop", H::PTHREAD, nullptr, nullptr},
+    {"pthread_cond_broadcast", H::PTHREAD, nullptr, nullptr},
+    {"pthread_cond_destroy", H::PTHREAD, nullptr, nullptr},
+    {"pthread_cond_init", H::PTHREAD, nullptr, nullptr},
+    {"pthread_cond_signal", H::PTHREAD, nullptr, nullptr},
+    {"pthread_cond_timedwait", H::PTHREAD, nullptr, nullptr},
+    {"pthread_cond_wait", H::PTHREAD, nullptr, nullptr},
+    {"pthread_condattr_destroy", H::PTHREAD, nullptr, nullptr},
+    {"pthread_condattr_getpshared", H::PTHREAD, nullptr, nullptr},
+    {"pthread_condattr_init", H::PTHREAD, nullptr, nullptr},
+    {"pthread_condattr_setpshared", H::PTHREAD, nullptr, nullptr},
+    {"pthread_create", H::PTHREAD, nullptr, nullptr},
+    {"pthread_detach", H::PTHREAD, nullptr, nullptr},
+    {"pthread_equal", H::PTHREAD, nullptr, nullptr},
+    {"pthread_exit", H::PTHREAD, nullptr, nullptr},
+    {"pthread_getconcurrency", H::PTHREAD, nullptr, nullptr},
+    {"pthread_getschedparam", H::PTHREAD, nullptr, nullptr},
+    {"pthread_getspecific", H::PTHREAD, nullptr, nullptr},
+    {"pthread_join", H::PTHREAD, nullptr, nullptr},
+    {"pthread_key_create", H::PTHREAD, nullptr, nullptr},
+    {"pthread_key_delete", H::PTHREAD, nullptr, nullptr},
+    {"pthread_mutex_destroy", H::PTHREAD, nullptr, nullptr},
+    {"pthread_mutex_getprioceiling", H::PTHREAD, nullptr, nullptr},
+    {"pthread_mutex_init", H::PTHREAD, nullptr, nullptr},
+    {"pthread_mutex_lock", H::PTHREAD, nullptr, nullptr},
+    {"pthread_mutex_setprioceiling", H::PTHREAD, nullptr, nullptr},
+    {"pthread_mutex_trylock", H::PTHREAD, nullptr, nullptr},
+    {"pthread_mutex_unlock", H::PTHREAD, nullptr, nullptr},
+    {"pthread_mutexattr_destroy", H::PTHREAD, nullptr, nullptr},
+    {"pthread_mutexattr_getprioceiling", H::PTHREAD, nullptr, nullptr},
+    {"pthread_mutexattr_getprotocol", H::PTHREAD, nullptr, nullptr},
+    {"pthread_mutexattr_getpshared", H::PTHREAD, nullptr, nullptr},
+    {"pthread_mutexattr_gettype", H::PTHREAD, nullptr, nullptr},
+    {"pthread_mutexattr_init", H::PTHREAD, nullptr, nullptr},
+    {"pthread_mutexattr_setprioceiling", H::PTHREAD, nullptr, nullptr},
+    {"pthread_mutexattr_setprotocol", H::PTHREAD, nullptr, nullptr},
+    {"pthread_mutexattr_setpshared", H::PTHREAD, nullptr, nullptr},
+    {"pthread_mutexattr_settype", H::PTHREAD, nullptr, nullptr},
+    {"pthread_once", H::PTHREAD, nullptr, nullptr},
+    {"pthread_rwlock_destroy", H::PTHREAD, nullptr, nullptr},
+    {"pthread_rwlock_init", H::PTHREAD, nullptr, nullptr},
+    {"pthread_rwlock_rdlock", H::PTHREAD, nullptr, nullptr},
+    {"pthread_rwlock_tryrdlock", H::PTHREAD, nullptr, nullptr},
+    {"pthread_rwlock_trywrlock", H::PTHREAD, nullptr, nullptr},
+    {"pthread_rwlock_unlock", H::PTHREAD, nullptr, nullptr},
+    {"pthread_rwlock_wrlock", H::PTHREAD, nullptr, nullptr},
+    {"pthread_rwlockattr_destroy", H::PTHREAD, nullptr, nullptr},
+    {"pthread_rwlockattr_getpshared", H::PTHREAD, nullptr, nullptr},
+    {"pthread_rwlockattr_init", H::PTHREAD, nullptr, nullptr},
+    {"pthread_rwlockattr_setpshared", H::PTHREAD, nullptr, nullptr},
+    {"pthread_self", H::PTHREAD, nullptr, nullptr},
+    {"pthread_setcancelstate", H::PTHREAD, nullptr, nullptr},
+    {"pthread_setcanceltype", H::PTHREAD, nullptr, nullptr},
+    {"pthread_setconcurrency", H::PTHREAD, nullptr, nullptr},
+    {"pthread_setschedparam", H::PTHREAD, nullptr, nullptr},
+    {"pthread_setspecific", H::PTHREAD, nullptr, nullptr},
+    {"pthread_testcancel", H::PTHREAD, nullptr, nullptr},
+
+    //math.h, float and long double variants are used by intrinsics with these types
+    {"sqrt", H::MATH, "double sqrt(double)", "dd"},
+    {"sqrtf", H::MATH, "float sqrtf(float)", "ff"},
+    {"sqrtl", H::MATH, "long double sqrtl(long double)", "ll"},
+    {"cbrt", H::MATH, "double cbrt(double)", "dd"},
+    {"sin", H::MATH, "double sin(double)", "dd"},
+    {"sinf", H::MATH, "float sinf(float)", "ff"},
+    {"sinl", H::MATH, "long double sinl(long double)", "ll"},
+    {"cos", H::MATH, "double cos(double)", "dd"},
+    {"cosf", H::MATH, "float cosf(float)", "ff"},
+    {"cosl", H::MATH, "long double cosl(long double)", "ll"},
+    {"tan", H::MATH, "double tan(double)", "dd"},
+    {"asin", H::MATH, "double asin(double)", "dd"},
+    {"acos", H::MATH, "double acos(double)", "dd"},
+    {"atan", H::MATH, "double atan(double)", "dd"},
+    {"atan2", H::MATH, "double atan2(double, double)", "ddd"},
+    {"sinh", H::MATH, "double sinh(double)", "dd"},
+    {"cosh", H::MATH, "double cosh(double)", "dd"},
+    {"tanh", H::MATH, "double tanh(double)", "dd"},
+    {"pow", H::MATH, "double pow(double, double)", "ddd"},
+    {"powf", H::MATH, "float powf(float, float)", "fff"},
+    {"powl", H::MATH, "long double powl(long double, long double)", "lll"},
+    {"exp", H::MATH, "double exp(double)", "dd"},
+    {"expf", H::MATH, "float expf(float)", "ff"},
+    {"expl", H::MATH, "long double expl(long double)", "ll"},
+    {"exp2", H::MATH, "double exp2(double)", "dd"},
+    {"exp2f", H::MATH, "float exp2f(float)", "ff"},
+    {"exp2l", H::MATH, "long double exp2l(long double)", "ll"},
+    {"log", H::MATH, "double log(double)", "dd"},
+    {"logf", H::MATH, "float logf(float)", "ff"},
+    {"logl", H::MATH, "long double logl(long double)", "ll"},
+    {"log10", H::MATH, "double log10(double)", "dd"},
+    {"log10f", H::MATH, "float log10f(float)", "ff"},
+    {"log10l", H::MATH, "long double log10l(long double)", "ll"},
+    {"log2", H::MATH, "double log2(double)", "dd"},
+    {"log2f", H::MATH, "float log2f(float)", "ff"},
+    {"log2l", H::MATH, "long double log2l(long double)", "ll"},
+    {"fma", H::MATH, "double fma(double, double, double)", "dddd"},
+    {"fmaf", H::MATH, "float fmaf(float, float, float)", "ffff"},
+    {"fmal", H::MATH, "long double fmal(long double, long double, long double)", "llll"},
+    {"fabs", H::MATH, "double fabs(double)", "dd"},
+    {"fabsf", H::MATH, "float fabsf(float)", "ff"},
+    {"fabsl", H::MATH, "long double fabsl(long double)", "ll"},
+    {"fmin", H::MATH, "double fmin(double, double)", "ddd"},
+    {"fmax", H::MATH, "double fmax(double, double)", "ddd"},
+    {"fmod", H::MATH, "double fmod(double, double)", "ddd"},
+    {"copysign", H::MATH, "double copysign(double, double)", "ddd"},
+    {"copysignf", H::MATH, "float copysignf(float, float)", "fff"},
+    {"copysignl", H::MATH, "long double copysignl(long double, long double)", "lll"},
+    {"floor", H::MATH, "double floor(double)", "dd"},
+    {"floorf", H::MATH, "float floorf(float)", "ff"},
+    {"floorl", H::MATH, "long double floorl(long double)", "ll"},
+    {"ceil", H::MATH, "double ceil(double)", "dd"},
+    {"ceilf", H::MATH, "float ceilf(float)", "ff"},
+    {"ceill", H::MATH, "long double ceill(long double)", "ll"},
+    {"trunc", H::MATH, "double trunc(double)", "dd"},
+    {"truncf", H::MATH, "float truncf(float)", "ff"},
+    {"truncl", H::MATH, "long double truncl(long double)", "ll"},
+    {"rint", H::MATH, "double rint(double)", "dd"},
+    {"rintf", H::MATH, "float rintf(float)", "ff"},
+    {"rintl", H::MATH, "long double rintl(long double)", "ll"},
+    {"nearbyint", H::MATH, "double nearbyint(double)", "dd"},
+    {"nearbyintf", H::MATH, "float nearbyintf(float)", "ff"},
+    {"nearbyintl", H::MATH, "long double nearbyintl(long double)", "ll"},
+    {"round", H::MATH, "double round(double)", "dd"},
+    {"roundf", H::MATH, "float roundf(float)", "ff"},
+    {"roundl", H::MATH, "long double roundl(long double)", "ll"},
+    {"lround", H::MATH, "long lround(double)", "nd"},
+    {"ldexp", H::MATH, "double ldexp(double, int)", "ddi"},
+    {"frexp", H::MATH, "double frexp(double, int*)", "ddp"},
+    {"modf", H::MATH, "double modf(double, double*)", "ddp"},
+
+    //ctype.h
+    {"isalnum", H::CTYPE, "int isalnum(int)", "ii"},
+    {"isalpha", H::CTYPE, "int isalpha(int)", "ii"},
+    {"isdigit", H::CTYPE, "int isdigit(int)", "ii"},
+    {"isxdigit", H::CTYPE, "int isxdigit(int)", "ii"},
+    {"islower", H::CTYPE, "int islower(int)", "ii"},
+    {"isupper", H::CTYPE, "int isupper(int)", "ii"},
+    {"isspace", H::CTYPE, "int isspace(int)", "ii"},
+    {"isprint", H::CTYPE, "int isprint(int)", "ii"},
+    {"ispunct", H::CTYPE, "int ispunct(int)", "ii"},
+    {"iscntrl", H::CTYPE, "int iscntrl(int)", "ii"},
+    {"tolower", H::CTYPE, "int tolower(int)", "ii"},
+    {"toupper", H::CTYPE, "int toupper(int)", "ii"},
+
+    //unistd.h
+    {"read", H::UNISTD, nullptr, nullptr},
+    {"write", H::UNISTD, nullptr, nullptr},
+    {"lseek", H::UNISTD, nullptr, nullptr},
+    {"fork", H::UNISTD, nullptr, nullptr},
+    {"getpid", H::UNISTD, nullptr, nullptr},
+    {"usleep", H::UNISTD, nullptr, nullptr},
+    {"close", H::UNISTD, "int close(int)", "ii"},
+    {"dup", H::UNISTD, "int dup(int)", "ii"},
+    {"dup2", H::UNISTD, "int dup2(int, int)", "iii"},
+    {"pipe", H::UNISTD, "int pipe(int*)", "ip"},
+    {"isatty", H::UNISTD, "int isatty(int)", "ii"},
+    {"access", H::UNISTD, "int access(const char*, int)", "ipi"},
+    {"unlink", H::UNISTD, "int unlink(const char*)", "ip"},
+    {"rmdir", H::UNISTD, "int rmdir(const char*)", "ip"},
+    {"chdir", H::UNISTD, "int chdir(const char*)", "ip"},
+    {"getcwd", H::UNISTD, "char* getcwd(char*, __SIZE_TYPE__)", "ppn"},
+    {"sleep", H::UNISTD, "unsigned int sleep(unsigned int)", "ii"},
+    {"_exit", H::UNISTD, "void _exit(int)", "vi"},
+
+    //time.h, all functions use types from the header
+    {"time", H::TIME, nullptr, nullptr},
+    {"clock", H::TIME, nullptr, nullptr},
+    {"difftime", H::TIME, nullptr, nullptr},
+    {"mktime", H::TIME, nullptr, nullptr},
+    {"localtime", H::TIME, nullptr, nullptr},
+    {"gmtime", H::TIME, nullptr, nullptr},
+    {"strftime", H::TIME, nullptr, nullptr},
+    {"nanosleep", H::TIME, nullptr, nullptr},
+};
+
+const static char* HEADER_NAMES[] = {"stdlib.h", "string.h", "stdio.h", "pthread.h", "math.h", "ctype.h", "strings.h", "unistd.h", "time.h"};
+
+static_assert(sizeof(HEADER_NAMES) / sizeof(HEADER_NAMES[0]) == static_cast<unsigned>(LibcHeader::COUNT), "every header needs a name");
+
+/*
+ * The table is perfectly hashed by hash and displace: names are distributed into buckets by a hash with seed 0,
+ * then for every bucket (the largest first) a seed is found, which places all names of the bucket into free slots.
+ * A lookup computes two hashes and compares one name.
+ */
+
+constexpr static std::size_t FUNCTION_COUNT = sizeof(LIBC_FUNCTIONS) / sizeof(LIBC_FUNCTIONS[0]);
+constexpr static std::size_t BUCKET_COUNT = FUNCTION_COUNT / 4 + 1;
+constexpr static std::size_t SLOT_COUNT = FUNCTION_COUNT * 2;
+constexpr static unsigned MAX_SEED = 1 << 12;
+
+constexpr static std::size_t getLength(const char* str) {
+    std::size_t length = 0;
+    while (str[length]) {
+        length++;
+    }
+    return length;
+}
+
+/**
+ * @brief getHash FNV-1a hash of the name with given seed, finalized by the MurmurHash3 mixer so that the seeds give independent hashes.
+ */
+constexpr static unsigned getHash(const char* name, std::size_t length, unsigned seed) {
+    unsigned hash = 2166136261u ^ (seed * 0x9e3779b9u);
+    for (std::size_t i = 0; i < length; i++) {
+        hash ^= static_cast<unsigned char>(name[i]);
+        hash *= 16777619u;
+    }
+
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+constexpr static std::size_t getSlot(std::size_t function, unsigned seed) {
+    return getHash(LIBC_FUNCTIONS[function].name, getLength(LIBC_FUNCTIONS[function].name), seed) % SLOT_COUNT;
+}
+
+struct PerfectHash {
+    unsigned seeds[BUCKET_COUNT] = {}; //seed of the slot hash for every bucket
+    int slots[SLOT_COUNT] = {}; //index into LIBC_FUNCTIONS, -1 for free slots
+    bool complete = false; //all functions were placed
+};
+
+constexpr static PerfectHash buildPerfectHash() {
+    PerfectHash result;
+    for (std::size_t slot = 0; slot < SLOT_COUNT; slot++) {
+        result.slots[slot] = -1;
+    }
+
+    std::size_t bucketOf[FUNCTION_COUNT] = {};
+    std::size_t bucketSizes[BUCKET_COUNT] = {};
+    std::size_t maxSize = 0;
+    for (std::size_t i = 0; i < FUNCTION_COUNT; i++) {
+        bucketOf[i] = getHash(LIBC_FUNCTIONS[i].name, getLength(LIBC_FUNCTIONS[i].name), 0) % BUCKET_COUNT;
+        bucketSizes[bucketOf[i]]++;
+        if (bucketSizes[bucketOf[i]] > maxSize) {
+            maxSize = bucketSizes[bucketOf[i]];
+        }
+    }
+
+    //larger buckets are placed first, while most of the slots are free
+    for (std::size_t size = maxSize; size > 0; size--) {
+        for (std::size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+            if (bucketSizes[bucket] != size) {
+                continue;
+            }
+
+            std::size_t members[FUNCTION_COUNT] = {};
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < FUNCTION_COUNT; i++) {
+                if (bucketOf[i] == bucket) {
+                    members[count++] = i;
+                }
+            }
+
+            bool placed = false;
+            unsigned seed = 1;
+            for (; seed < MAX_SEED && !placed; seed++) {
+                placed = true;
+                for (std::size_t j = 0; j < count; j++) {
+                    std::size_t slot = getSlot(members[j], seed);
+                    if (result.slots[slot] != -1) {
+                        //frees slots taken by this attempt
+                        for (std::size_t k = 0; k < j; k++) {
+                            result.slots[getSlot(members[k], seed)] = -1;
+                        }
+                        placed = false;
+                        break;
+                    }
+                    result.slots[slot] = static_cast<int>(members[j]);
+                }
+            }
+
+            if (!placed) {
+                return result;
+            }
+            result.seeds[bucket] = seed - 1;
+        }
+    }
+
+    result.complete = true;
+    return result;
+}
+
+constexpr static PerfectHash HASH = buildPerfectHash();
+
+static_assert(HASH.complete, "perfect hash of library functions cannot be built, increase MAX_SEED or SLOT_COUNT");
+
+const LibcFunction* getLibcFunction(llvm::StringRef name) {
+    unsigned seed = HASH.seeds[getHash(name.data(), name.size(), 0) % BUCKET_COUNT];
+    int index = HASH.slots[getHash(name.data(), name.size(), seed) % SLOT_COUNT];
+    if (index == -1 || name != LIBC_FUNCTIONS[index].name) {
+        return nullptr;
+    }
+
+    return &LIBC_FUNCTIONS[index];
+}
+
+const char* getLibcHeaderName(LibcHeader header) {
+    return HEADER_NAMES[static_cast<unsigned>(header)];
+}
+
+/**
+ * @brief getIntegerWidth Returns width of the integer kind in bits, 0 for other kinds.
+ */
+static unsigned getIntegerWidth(char kind, const llvm::DataLayout& layout) {
+    switch (kind) {
+    case 'c':
+        return 8;
+    case 's':
+        return 16;
+    case 'i':
+        return 32;
+    case 'n':
+        return layout.getPointerSizeInBits();
+    case 'q':
+        return 64;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief matchesKind Checks whether the type corresponds to the kind used in LibcFunction::kinds.
+ */
+static bool matchesKind(const llvm::Type* type, char kind, const llvm::DataLayout& layout) {
+    if (type->isIntegerTy()) {
+        return type->getIntegerBitWidth() == getIntegerWidth(kind, layout);
+    }
+
+    switch (kind) {
+    case 'v':
+        return type->isVoidTy();
+    case 'f':
+        return type->isFloatTy();
+    case 'd':
+        return type->isDoubleTy();
+    case 'l':
+        return type->isX86_FP80Ty();
+    case 'p':
+        return type->isPointerTy();
+    default:
+        return false;
+    }
+}
+
+bool hasCompatibleSignature(const LibcFunction& function, const llvm::FunctionType* type, const llvm::DataLayout& layout) {
+    if (!function.signature) {
+        return false;
+    }
+
+    if (type->isVarArg() != (std::strstr(function.signature, "...") != nullptr)) {
+        return false;
+    }
+
+    if (type->getNumParams() + 1 != std::strlen(function.kinds)) {
+        return false;
+    }
+
+    //result of a void function cannot be used, so any canonical return type is fine
+    if (!type->getReturnType()->isVoidTy() && !matchesKind(type->getReturnType(), function.kinds[0], layout)) {
+        return false;
+    }
+
+    for (unsigned i = 0; i < type->getNumParams(); i++) {
+        if (!matchesKind(type->getParamType(i), function.kinds[i + 1], layout)) {
+            return false;
+        }
+    }
+
+    return true;
+}
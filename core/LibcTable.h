@@ -0,0 +1,57 @@
+#pragma once
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/IR/DataLayout.h"
+#include "llvm/IR/DerivedTypes.h"
+
+/**
+ * @brief The LibcHeader enum contains headers declaring functions from the LibcTable, in the order in which they are included.
+ */
+enum class LibcHeader : unsigned {
+    STDLIB,
+    STRING,
+    STDIO,
+    PTHREAD,
+    MATH,
+    CTYPE,
+    STRINGS,
+    UNISTD,
+    TIME,
+    COUNT
+};
+
+/**
+ * @brief The LibcFunction struct describes a function from the C standard library, POSIX or math library.
+ */
+struct LibcFunction {
+    const char* name;
+    LibcHeader header; //header declaring the function
+    const char* signature; //canonical prototype using only built-in types, nullptr if it needs types from the header
+    const char* kinds; //kinds of the return type and parameters of the signature ('v'oid, 'c'har, 's'hort, 'i'nt, 'n' for long and size_t,
+                       //'q' for long long, 'f'loat, 'd'ouble, 'l'ong double, 'p'ointer)
+};
+
+/**
+ * @brief getLibcFunction Looks up the function in the table of known library functions. The table is perfectly hashed during compilation.
+ * @param name Name of the function
+ * @return Pointer to the description of the function, nullptr if the function is not known
+ */
+const LibcFunction* getLibcFunction(llvm::StringRef name);
+
+/**
+ * @brief getLibcHeaderName Returns the name of the header, e.g. "stdio.h".
+ * @param header Header
+ * @return Name of the header
+ */
+const char* getLibcHeaderName(LibcHeader header);
+
+/**
+ * @brief hasCompatibleSignature Checks whether the canonical signature of the function can be used for a declaration
+ * with given type, i.e. all calls valid for the type stay valid C with the canonical signature. Integers must have the width
+ * of the C type (char 8, short 16, int 32, long long 64 bits, long and size_t the width of a pointer).
+ * @param function Known library function
+ * @param type Type of the declared function in the module
+ * @param layout Data layout of the module, which gives the width of long and size_t
+ * @return True if the canonical signature can be used, false otherwise
+ */
+bool hasCompatibleSignature(const LibcFunction& function, const llvm::FunctionType* type, const llvm::DataLayout& layout);
@@ -0,0 +1,97 @@
+#include "MemoryReport.h"
+
+#include <fstream>
+#include <iomanip>
+
+bool MemoryReport::enabled = false;
+bool MemoryReport::countTotals = false;
+MemoryReport::Subsystem MemoryReport::current = MemoryReport::PROGRAM;
+MemoryReport::Counter MemoryReport::counters[SUBSYSTEM_COUNT][KIND_COUNT];
+std::size_t MemoryReport::totalAllocations[KIND_COUNT];
+std::size_t MemoryReport::live[KIND_COUNT];
+std::size_t MemoryReport::peakLive[KIND_COUNT];
+std::vector<MemoryReport::Phase> MemoryReport::phases;
+std::chrono::steady_clock::time_point MemoryReport::lastPhase = std::chrono::steady_clock::now();
+
+const static char* SUBSYSTEM_NAMES[] = {"Module", "Program", "Func", "Block", "TypeHandler", "Output"};
+const static char* KIND_NAMES[] = {"Expr", "Type", "Other"};
+
+static_assert(sizeof(SUBSYSTEM_NAMES) / sizeof(SUBSYSTEM_NAMES[0]) == MemoryReport::SUBSYSTEM_COUNT, "Every subsystem has to have a name");
+static_assert(sizeof(KIND_NAMES) / sizeof(KIND_NAMES[0]) == MemoryReport::KIND_COUNT, "Every kind has to have a name");
+
+void MemoryReport::phase(const std::string& name) {
+    if (!enabled) {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    phases.push_back({name, std::chrono::duration<double>(now - lastPhase).count(), readStatus("VmRSS:"), readStatus("VmHWM:")});
+    lastPhase = now;
+}
+
+std::size_t MemoryReport::readStatus(const std::string& field) {
+    std::ifstream status("/proc/self/status");
+    std::string name;
+
+    while (status >> name) {
+        if (name == field) {
+            std::size_t value = 0;
+            status >> value;
+            return value;
+        }
+        status.ignore(256, '\n');
+    }
+
+    return 0;
+}
+
+void MemoryReport::print(std::ostream& stream, bool json) {
+    if (json) {
+        stream << "{\n  \"phases\": [";
+        for (unsigned i = 0; i < phases.size(); i++) {
+            stream << (i == 0 ? "\n" : ",\n");
+            stream << "    {\"name\": \"" << phases[i].name << "\", \"seconds\": " << phases[i].seconds
+                   << ", \"rss_kb\": " << phases[i].rss << ", \"peak_rss_kb\": " << phases[i].peakRss << "}";
+        }
+        stream << "\n  ],\n  \"allocations\": {";
+        for (unsigned i = 0; i < SUBSYSTEM_COUNT; i++) {
+            stream << (i == 0 ? "\n" : ",\n");
+            stream << "    \"" << SUBSYSTEM_NAMES[i] << "\": {";
+            for (unsigned j = 0; j < KIND_COUNT; j++) {
+                stream << (j == 0 ? "" : ", ");
+                stream << "\"" << KIND_NAMES[j] << "\": {\"count\": " << counters[i][j].allocations << ", \"bytes\": " << counters[i][j].bytes << "}";
+            }
+            stream << "}";
+        }
+        stream << "\n  },\n";
+        stream << "  \"peak_live_bytes\": {\"Expr\": " << peakLive[EXPR] << ", \"Type\": " << peakLive[TYPE] << "}\n}\n";
+        return;
+    }
+
+    stream << "===-------------------------------------------------------------------------===\n";
+    stream << "                              Memory report\n";
+    stream << "===-------------------------------------------------------------------------===\n";
+    stream << std::left << std::setw(24) << "Phase" << std::right << std::setw(12) << "Time (s)"
+           << std::setw(14) << "RSS (MB)" << std::setw(16) << "Peak RSS (MB)" << "\n";
+    stream << std::fixed << std::setprecision(3);
+    for (const auto& phase : phases) {
+        stream << std::left << std::setw(24) << phase.name << std::right << std::setw(12) << phase.seconds
+               << std::setw(14) << phase.rss / 1024.0 << std::setw(16) << phase.peakRss / 1024.0 << "\n";
+    }
+
+    stream << "\n" << std::left << std::setw(14) << "Subsystem";
+    for (unsigned j = 0; j < KIND_COUNT; j++) {
+        stream << std::right << std::setw(12) << KIND_NAMES[j] << std::setw(14) << "(MB)";
+    }
+    stream << "\n";
+    for (unsigned i = 0; i < SUBSYSTEM_COUNT; i++) {
+        stream << std::left << std::setw(14) << SUBSYSTEM_NAMES[i];
+        for (unsigned j = 0; j < KIND_COUNT; j++) {
+            stream << std::right << std::setw(12) << counters[i][j].allocations << std::setw(14) << counters[i][j].bytes / (1024.0 * 1024.0);
+        }
+        stream << "\n";
+    }
+
+    stream << "\nPeak live Expr nodes: " << peakLive[EXPR] / (1024.0 * 1024.0) << " MB, peak live Type objects: " << peakLive[TYPE] / (1024.0 * 1024.0) << " MB\n";
+    stream << std::defaultfloat;
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The MemoryReport class collects memory usage of the translation. It records RSS and time at the boundaries
+ * of translation phases and counts allocations by the subsystem that made them (set by MemoryReport::Scope)
+ * and by their kind (Expr nodes, Type objects and other allocations, mostly strings and containers).
+ * All members are static, as allocations are counted by operator new. Expr and Type count their allocations themselves,
+ * other allocations are counted only by the llvm2c executable, which replaces the global operator new.
+ */
+class MemoryReport {
+public:
+    enum Subsystem {
+        MODULE, //LLVM module parsing
+        PROGRAM,
+        FUNC,
+        BLOCK,
+        TYPE_HANDLER,
+        OUTPUT, //output buffers and strings created during output
+        SUBSYSTEM_COUNT
+    };
+
+    enum Kind {
+        EXPR,
+        TYPE,
+        OTHER,
+        KIND_COUNT
+    };
+
+    /**
+     * @brief The Scope class attributes allocations made during its lifetime to the given subsystem.
+     */
+    class Scope {
+    private:
+        Subsystem previous;
+
+    public:
+        Scope(Subsystem subsystem)
+            : previous(current) {
+            current = subsystem;
+        }
+
+        ~Scope() {
+            current = previous;
+        }
+    };
+
+    static bool enabled; //allocations are counted only if the report is enabled
+    static bool countTotals; //total numbers of allocations are counted even without the report (used by the cost report)
+
+    /**
+     * @brief allocated Counts allocation of given kind in the current subsystem.
+     * @param kind Kind of the allocated object
+     * @param size Size of the allocation in bytes
+     */
+    static void allocated(Kind kind, std::size_t size) {
+        if (countTotals) {
+            totalAllocations[kind]++;
+        }
+        if (enabled) {
+            counters[current][kind].allocations++;
+            counters[current][kind].bytes += size;
+            live[kind] += size;
+            if (live[kind] > peakLive[kind]) {
+                peakLive[kind] = live[kind];
+            }
+        }
+    }
+
+    /**
+     * @brief deallocated Counts deallocation of given kind, used only for kinds whose deallocation size is known.
+     * @param kind Kind of the deallocated object
+     * @param size Size of the deallocation in bytes
+     */
+    static void deallocated(Kind kind, std::size_t size) {
+        if (enabled && live[kind] >= size) {
+            live[kind] -= size;
+        }
+    }
+
+    /**
+     * @brief getAllocationCount Returns number of allocations of given kind since the start of the program.
+     * Allocations are counted only if countTotals is set.
+     * @param kind Kind of allocated objects
+     * @return Number of allocations
+     */
+    static std::size_t getAllocationCount(Kind kind) {
+        return totalAllocations[kind];
+    }
+
+    /**
+     * @brief phase Records the end of translation phase with current and peak RSS.
+     * @param name Name of the phase
+     */
+    static void phase(const std::string& name);
+
+    /**
+     * @brief print Prints the report.
+     * @param stream Stream for output
+     * @param json Report is printed as JSON instead of text
+     */
+    static void print(std::ostream& stream, bool json);
+
+private:
+    struct Counter {
+        std::size_t allocations = 0;
+        std::size_t bytes = 0;
+    };
+
+    struct Phase {
+        std::string name;
+        double seconds; //duration of the phase
+        std::size_t rss; //RSS at the end of the phase in kB
+        std::size_t peakRss; //peak RSS at the end of the phase in kB
+    };
+
+    static Subsystem current;
+    static Counter counters[SUBSYSTEM_COUNT][KIND_COUNT];
+    static std::size_t totalAllocations[KIND_COUNT];
+    static std::size_t live[KIND_COUNT]; //bytes currently allocated, precise only for Expr and Type
+    static std::size_t peakLive[KIND_COUNT];
+    static std::vector<Phase> phases;
+    static std::chrono::steady_clock::time_point lastPhase;
+
+    /**
+     * @brief readStatus Reads value of the field (in kB) from /proc/self/status.
+     * @param field Name of the field including colon (e.g. "VmRSS:")
+     * @return Value of the field, 0 if it is not available
+     */
+    static std::size_t readStatus(const std::string& field);
+};
@@ -0,0 +1,40 @@
+#include "NameService.h"
+
+//created names never have more digits, larger numbers cannot collide and would not fit into DenseSet
+const static unsigned MAX_DIGITS = 9;
+
+void NameService::reserve(llvm::StringRef name) {
+    unsigned number;
+    if (getVarNumber(name, number)) {
+        reserved.insert(number);
+    }
+}
+
+std::string NameService::getVarName() {
+    while (isReserved(count)) {
+        count++;
+    }
+
+    return "var" + std::to_string(count++);
+}
+
+bool NameService::getVarNumber(llvm::StringRef name, unsigned& number) {
+    if (!name.consume_front("var") || name.empty() || name.size() > MAX_DIGITS) {
+        return false;
+    }
+
+    //names with leading zeros are never created
+    if (name.size() > 1 && name.front() == '0') {
+        return false;
+    }
+
+    number = 0;
+    for (char c : name) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        number = number * 10 + (c - '0');
+    }
+
+    return true;
+}
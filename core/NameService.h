@@ -0,0 +1,64 @@
+#pragma once
+
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <string>
+
+/**
+ * @brief The NameService class creates names of variables in form of "var" + number, which do not collide with names
+ * of variables from the module (global variables and variables from debug information). Only names in the same form
+ * can collide, so they are reserved as numbers. Function name services share the reserved names of the module
+ * name service instead of copying them.
+ */
+class NameService {
+private:
+    const NameService* parent; //name service with names reserved for the whole module, nullptr for the module itself
+    llvm::DenseSet<unsigned> reserved; //numbers of reserved names
+    unsigned count = 0; //number of the next created name
+
+public:
+    /**
+     * @brief NameService Constructor of a NameService class.
+     * @param parent Name service whose reserved names are also avoided, nullptr if there is none
+     */
+    NameService(const NameService* parent = nullptr)
+        : parent(parent) { }
+
+    /**
+     * @brief reserve Reserves the name, so it is never created by getVarName. Names in other form than "var" + number are ignored.
+     * @param name Name of a variable from the module
+     */
+    void reserve(llvm::StringRef name);
+
+    /**
+     * @brief isReserved Returns whether the name with given number is reserved in this or the parent name service.
+     * @param number Number of the name
+     * @return True if the name is reserved, false otherwise
+     */
+    bool isReserved(unsigned number) const {
+        return reserved.count(number) || (parent && parent->isReserved(number));
+    }
+
+    /**
+     * @brief getVarName Creates a new name for a variable in form of string containing "var" + number, skipping reserved names.
+     * @return String containing a new variable name
+     */
+    std::string getVarName();
+
+    /**
+     * @brief getCount Returns number of names created or skipped so far.
+     * @return Number of the next created name
+     */
+    unsigned getCount() const {
+        return count;
+    }
+
+    /**
+     * @brief getVarNumber Parses number from the name in form of "var" + number, as it would be created by getVarName.
+     * @param name Name of a variable
+     * @param number Parsed number
+     * @return True if the name is in the form, false otherwise
+     */
+    static bool getVarNumber(llvm::StringRef name, unsigned& number);
+};
@@ -4,36 +4,332 @@
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/IRReader/IRReader.h"
 #include "llvm/IR/Constants.h"
-
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/DebugInfoMetadata.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/BinaryFormat/Magic.h"
+#include "llvm/Linker/Linker.h"
+#include "llvm/Object/Archive.h"
+
+#include "Compression.h"
+#include "MemoryReport.h"
+#include "Trace.h"
 #include "../type/Type.h"
 
 #include <fstream>
 #include <exception>
 #include <algorithm>
-#include <regex>
 #include <iostream>
+#include <sstream>
+#include <cctype>
+#include <chrono>
+#include <functional>
+
+const static std::string MANIFEST_NAME = "llvm2c.manifest";
+const static std::string MANIFEST_VERSION = "llvm2c-manifest-1";
+const static std::string HEADER_NAME = "module.h";
+const static std::string GLOBALS_NAME = "globals.c";
+
+Program::Program(const std::string &file, bool includes, bool casts, bool lazy)
+    : Program(std::vector<std::string>{file}, includes, casts, lazy) { }
 
-Program::Program(const std::string &file, bool includes, bool casts)
+Program::Program(const std::vector<std::string>& files, bool includes, bool casts, bool lazy, bool eliminateDead, const std::vector<std::string>& roots)
     : typeHandler(TypeHandler(this)),
+      constantHandler(ConstantHandler(this)),
       includes(includes),
-      noFuncCasts(casts) {
+      noFuncCasts(casts),
+      lazy(lazy) {
     error = llvm::SMDiagnostic();
-    module = llvm::parseIRFile(file, error, context);
+    for (const auto& file : files) {
+        loadFile(file);
+    }
     if(!module) {
-        throw std::invalid_argument("Error loading module - invalid input file:\n" + file + "\n");
+        throw std::invalid_argument("Error loading module - no input file!\n");
+    }
+
+    if (files.size() == 1) {
+        llvm::outs() << "IR file successfuly parsed.\n";
+    } else {
+        llvm::outs() << "IR files successfuly parsed and linked.\n";
+    }
+    MemoryReport::phase("IR parsing");
+
+    if (eliminateDead) {
+        eliminateDeadCode(roots);
+        MemoryReport::phase("dead code elimination");
+    }
+
+    parseProgram();
+}
+
+Program::Program(llvm::MemoryBufferRef buffer, bool includes, bool casts, bool lazy)
+    : typeHandler(TypeHandler(this)),
+      constantHandler(ConstantHandler(this)),
+      includes(includes),
+      noFuncCasts(casts),
+      lazy(lazy) {
+    error = llvm::SMDiagnostic();
+    loadBuffer(buffer);
+    if(!module) {
+        throw std::invalid_argument("Error loading module - invalid input:\n" + buffer.getBufferIdentifier().str() + "\n");
     }
 
-    llvm::outs() << "IR file successfuly parsed.\n";
+    llvm::outs() << "IR successfuly parsed.\n";
+    MemoryReport::phase("IR parsing");
 
     parseProgram();
 }
 
+void Program::loadFile(const std::string& file) {
+    auto bufferOrError = llvm::MemoryBuffer::getFileOrSTDIN(file);
+    if (!bufferOrError) {
+        throw std::invalid_argument("Error loading module - invalid input file:\n" + file + "\n");
+    }
+
+    loadBuffer((*bufferOrError)->getMemBufferRef());
+}
+
+void Program::loadBuffer(llvm::MemoryBufferRef buffer) {
+    MemoryReport::Scope memoryScope(MemoryReport::MODULE);
+    Trace::Span span("parseIR", buffer.getBufferIdentifier());
+
+    std::string name = buffer.getBufferIdentifier().str();
+
+    //compressed modules and archives are decompressed in memory
+    std::unique_ptr<llvm::MemoryBuffer> decompressed;
+    if (isGzip(buffer.getBuffer())) {
+        decompressed = decompressGzip(buffer.getBuffer(), name);
+        buffer = decompressed->getMemBufferRef();
+    }
+
+    if (llvm::identify_magic(buffer.getBuffer()) != llvm::file_magic::archive) {
+        std::unique_ptr<llvm::Module> parsed = llvm::parseIR(buffer, error, context);
+        if (!parsed) {
+            throw std::invalid_argument("Error loading module - invalid input file:\n" + name + "\n");
+        }
+
+        linkModule(std::move(parsed), name);
+        return;
+    }
+
+    auto archive = llvm::object::Archive::create(buffer);
+    if (!archive) {
+        throw std::invalid_argument("Error loading module - invalid archive:\n" + name + "\n" + llvm::toString(archive.takeError()) + "\n");
+    }
+
+    //members are collected first, so that errors of the archive iteration are checked before throwing
+    std::vector<std::pair<std::string, llvm::MemoryBufferRef>> memberBuffers;
+    std::string memberError;
+    llvm::Error err = llvm::Error::success();
+    for (const auto& child : (*archive)->children(err)) {
+        auto childName = child.getName();
+        if (!childName) {
+            memberError = llvm::toString(childName.takeError());
+            break;
+        }
+
+        auto member = child.getMemoryBufferRef();
+        if (!member) {
+            memberError = llvm::toString(member.takeError());
+            break;
+        }
+
+        memberBuffers.push_back({name + "(" + childName->str() + ")", *member});
+    }
+
+    if (err) {
+        throw std::invalid_argument("Error loading module - invalid archive:\n" + name + "\n" + llvm::toString(std::move(err)) + "\n");
+    }
+    if (!memberError.empty()) {
+        throw std::invalid_argument("Error loading module - invalid archive member:\n" + name + "\n" + memberError + "\n");
+    }
+
+    std::vector<std::pair<std::unique_ptr<llvm::Module>, std::string>> members;
+    for (const auto& memberBuffer : memberBuffers) {
+        //members are not null terminated, so only bitcode can be parsed
+        if (llvm::identify_magic(memberBuffer.second.getBuffer()) != llvm::file_magic::bitcode) {
+            throw std::invalid_argument("Error loading module - archive member is not a bitcode file:\n" + memberBuffer.first + "\n");
+        }
+
+        std::unique_ptr<llvm::Module> parsed = llvm::parseIR(memberBuffer.second, error, context);
+        if (!parsed) {
+            throw std::invalid_argument("Error loading module - invalid archive member:\n" + memberBuffer.first + "\n");
+        }
+
+        members.push_back({std::move(parsed), memberBuffer.first});
+    }
+
+    //archive given as the first input is linked whole, as there are no undefined symbols to select members by
+    if (!module) {
+        for (auto& member : members) {
+            linkModule(std::move(member.first), member.second);
+        }
+        return;
+    }
+
+    //otherwise the archive is used as a static library, only members defining undefined symbols are linked,
+    //which is repeated until no member is linked, as linked members can introduce new undefined symbols
+    bool linked = true;
+    while (linked) {
+        linked = false;
+        for (auto& member : members) {
+            if (member.first && definesUndefinedSymbol(*member.first)) {
+                linkModule(std::move(member.first), member.second);
+                linked = true;
+            }
+        }
+    }
+}
+
+bool Program::definesUndefinedSymbol(const llvm::Module& member) const {
+    for (const llvm::GlobalValue& GV : member.global_values()) {
+        if (GV.isDeclaration() || GV.hasLocalLinkage()) {
+            continue;
+        }
+
+        const llvm::GlobalValue* existing = module->getNamedValue(GV.getName());
+        if (existing && existing->isDeclaration()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Program::linkModule(std::unique_ptr<llvm::Module> linked, const std::string& name) {
+    if (!module) {
+        module = std::move(linked);
+        return;
+    }
+
+    Trace::Span span("linkModules", name);
+    if (llvm::Linker::linkModules(*module, std::move(linked))) {
+        throw std::invalid_argument("Error linking module:\n" + name + "\n");
+    }
+}
+
+void Program::eliminateDeadCode(const std::vector<std::string>& roots) {
+    Trace::Span span("eliminateDeadCode");
+
+    llvm::DenseSet<const llvm::GlobalValue*> live;
+    llvm::DenseSet<const llvm::Constant*> visitedConstants;
+    std::vector<const llvm::GlobalValue*> globalWorklist;
+    std::vector<const llvm::Constant*> constantWorklist;
+
+    auto markLive = [&](const llvm::Value* value) {
+        if (const auto GV = llvm::dyn_cast<llvm::GlobalValue>(value)) {
+            if (live.insert(GV).second) {
+                globalWorklist.push_back(GV);
+            }
+        } else if (const auto C = llvm::dyn_cast<llvm::Constant>(value)) {
+            //constants are visited only once, as they can be shared by many users
+            if (visitedConstants.insert(C).second) {
+                constantWorklist.push_back(C);
+            }
+        }
+    };
+
+    for (const llvm::GlobalValue& GV : module->global_values()) {
+        //llvm.used, llvm.global_ctors and similar arrays have appending linkage and are always kept
+        if (GV.hasAppendingLinkage() || (roots.empty() && !GV.isDeclaration() && !GV.hasLocalLinkage())) {
+            markLive(&GV);
+        }
+    }
+
+    for (const auto& root : roots) {
+        const llvm::GlobalValue* GV = module->getNamedValue(root);
+        if (!GV) {
+            throw std::invalid_argument("Root symbol " + root + " not found!\n");
+        }
+        markLive(GV);
+    }
+
+    while (!globalWorklist.empty() || !constantWorklist.empty()) {
+        if (!constantWorklist.empty()) {
+            const llvm::Constant* C = constantWorklist.back();
+            constantWorklist.pop_back();
+            for (const llvm::Use& op : C->operands()) {
+                markLive(op.get());
+            }
+            continue;
+        }
+
+        const llvm::GlobalValue* GV = globalWorklist.back();
+        globalWorklist.pop_back();
+
+        if (const auto F = llvm::dyn_cast<llvm::Function>(GV)) {
+            for (const llvm::BasicBlock& block : *F) {
+                for (const llvm::Instruction& ins : block) {
+                    for (const llvm::Use& op : ins.operands()) {
+                        markLive(op.get());
+                    }
+                }
+            }
+            if (F->hasPersonalityFn()) {
+                markLive(F->getPersonalityFn());
+            }
+        } else if (const auto var = llvm::dyn_cast<llvm::GlobalVariable>(GV)) {
+            if (var->hasInitializer()) {
+                markLive(var->getInitializer());
+            }
+        } else if (const auto alias = llvm::dyn_cast<llvm::GlobalAlias>(GV)) {
+            markLive(alias->getAliasee());
+        }
+    }
+
+    std::vector<llvm::GlobalValue*> dead;
+    unsigned functionCount = 0;
+    unsigned declarationCount = 0;
+    unsigned varCount = 0;
+    for (llvm::GlobalValue& GV : module->global_values()) {
+        if (!live.count(&GV)) {
+            dead.push_back(&GV);
+            if (llvm::isa<llvm::Function>(GV)) {
+                GV.isDeclaration() ? declarationCount++ : functionCount++;
+            } else if (llvm::isa<llvm::GlobalVariable>(GV)) {
+                varCount++;
+            }
+        }
+    }
+
+    //references between dead symbols are dropped first, so they can be erased in any order
+    for (llvm::GlobalValue* GV : dead) {
+        if (auto F = llvm::dyn_cast<llvm::Function>(GV)) {
+            F->dropAllReferences();
+        } else if (auto var = llvm::dyn_cast<llvm::GlobalVariable>(GV)) {
+            var->dropAllReferences();
+        } else {
+            GV->dropAllReferences();
+        }
+    }
+
+    for (llvm::GlobalValue* GV : dead) {
+        GV->removeDeadConstantUsers();
+        if (!GV->use_empty()) {
+            GV->replaceAllUsesWith(llvm::UndefValue::get(GV->getType()));
+        }
+        GV->eraseFromParent();
+    }
+
+    llvm::outs() << "Dead code elimination removed " << functionCount << " functions, " << declarationCount << " declarations and "
+                 << varCount << " global variables.\n";
+}
+
 void Program::parseProgram() {
     llvm::outs() << "Translating module...\n";
 
+    MemoryReport::Scope memoryScope(MemoryReport::PROGRAM);
+
     parseGlobalVars();
+    MemoryReport::phase("global variables");
     parseStructs();
+    MemoryReport::phase("structs");
+    parseFunctionTypes();
+    MemoryReport::phase("function types");
     parseFunctions();
+    MemoryReport::phase("functions");
 
     llvm::outs() << "Module successfuly translated.\n";
 
@@ -45,6 +341,8 @@ void Program::parseProgram() {
 }
 
 void Program::parseStructs() {
+    Trace::Span span("parseStructs");
+
     for (llvm::StructType* structType : module->getIdentifiedStructTypes()) {
         std::string structName = TypeHandler::getStructName(structType->getName().str());
 
@@ -65,24 +363,87 @@ void Program::parseStructs() {
             structExpr->addItem(getType(type), getStructVarName());
         }
 
+        setStructLayout(structExpr.get(), structType);
         structs.push_back(std::move(structExpr));
     }
 }
 
 void Program::parseFunctions() {
+    Trace::Span span("parseFunctions");
+
     for(const llvm::Function& func : module->functions()) {
         if (func.hasName()) {
+            //Func is created before it is inserted, as parsing of the function can add new declarations
             if (!func.isDeclaration()) {
-                functions[&func] = std::make_unique<Func>(&func, this, false);
-                if (!declarations.count(&func)) {
-                    declarations[&func] = std::make_unique<Func>(&func, this, true);
+                auto definition = std::make_unique<Func>(&func, this, false);
+                if (!lazy) {
+                    definition->parseFunction();
                 }
+                functions[&func] = std::move(definition);
+                addDeclaration(&func);
             }
 
             if (func.isDeclaration() || llvm::Function::isInternalLinkage(func.getLinkage())) {
                 if (func.getName().str().substr(0, 8) != "llvm.dbg") {
-                    if (!declarations.count(&func)) {
-                        declarations[&func] = std::make_unique<Func>(&func, this, true);
+                    addDeclaration(&func);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief isDirectCallee Checks whether the operand is the function called by a direct call. Direct calls are translated
+ * using the name of the function, so the type of the function pointer is never printed.
+ */
+static bool isDirectCallee(const llvm::Instruction& ins, const llvm::Use& operand) {
+    if (!llvm::isa<llvm::Function>(operand.get())) {
+        return false;
+    }
+
+    //arguments are always the first operands, the same function can be passed as an argument too
+    if (const llvm::CallInst* CI = llvm::dyn_cast<llvm::CallInst>(&ins)) {
+        return operand.getOperandNo() >= CI->getNumArgOperands() && operand.get() == CI->getCalledValue();
+    }
+    if (const llvm::InvokeInst* II = llvm::dyn_cast<llvm::InvokeInst>(&ins)) {
+        return operand.getOperandNo() >= II->getNumArgOperands() && operand.get() == II->getCalledValue();
+    }
+
+    return false;
+}
+
+void Program::parseFunctionTypes() {
+    Trace::Span span("parseFunctionTypes");
+
+    llvm::DenseSet<const llvm::Constant*> visited;
+    llvm::DenseSet<const llvm::Type*> types;
+
+    for (const llvm::Function& func : module->functions()) {
+        for (const llvm::BasicBlock& block : func) {
+            for (const llvm::Instruction& ins : block) {
+                parseTypeOnce(ins.getType(), types);
+
+                for (const llvm::Use& operand : ins.operands()) {
+                    if (isDirectCallee(ins, operand)) {
+                        continue;
+                    }
+
+                    if (const llvm::Constant* C = llvm::dyn_cast<llvm::Constant>(operand.get())) {
+                        parseConstantTypes(C, visited, types);
+                    } else {
+                        parseTypeOnce(operand->getType(), types);
+                    }
+                }
+
+                if (const llvm::CallInst* CI = llvm::dyn_cast<llvm::CallInst>(&ins)) {
+                    //musttail call is always followed by return, so it is always translated as a part of the return statement
+                    if (CI->isMustTailCall()) {
+                        hasMustTail = true;
+                    }
+
+                    const llvm::MemIntrinsic* MI = llvm::dyn_cast<llvm::MemIntrinsic>(CI);
+                    if (MI && MI->isVolatile()) {
+                        hasVolatileMem = true;
                     }
                 }
             }
@@ -90,7 +451,33 @@ void Program::parseFunctions() {
     }
 }
 
+void Program::parseConstantTypes(const llvm::Constant* constant, llvm::DenseSet<const llvm::Constant*>& visited, llvm::DenseSet<const llvm::Type*>& types) {
+    //constants without operands (e.g. integers) are too many to be kept in the set
+    if (constant->getNumOperands() != 0 && !visited.insert(constant).second) {
+        return;
+    }
+
+    parseTypeOnce(constant->getType(), types);
+
+    //operands of global values are their initializers, which are parsed separately
+    if (llvm::isa<llvm::GlobalValue>(constant)) {
+        return;
+    }
+
+    for (const llvm::Use& operand : constant->operands()) {
+        parseConstantTypes(llvm::cast<llvm::Constant>(operand.get()), visited, types);
+    }
+}
+
+void Program::parseTypeOnce(const llvm::Type* type, llvm::DenseSet<const llvm::Type*>& types) {
+    if (types.insert(type).second) {
+        getType(type);
+    }
+}
+
 void Program::parseGlobalVars() {
+    Trace::Span span("parseGlobalVars");
+
     for (const llvm::GlobalVariable& gvar : module->globals()) {
         if (llvm::isa<llvm::Function>(&gvar)) {
             continue;
@@ -104,20 +491,30 @@ void Program::parseGlobalVar(const llvm::GlobalVariable &gvar) {
     std::string gvarName = gvar.getName().str();
     std::replace(gvarName.begin(), gvarName.end(), '.', '_');
 
-    std::regex varName("var[0-9]+");
-    if (std::regex_match(gvarName, varName)) {
-        globalVarNames.insert(gvarName);
-    }
+    globalNames.reserve(gvarName);
 
+    //data initializers are output directly from LLVM constant, as they can be very large
+    const llvm::ConstantDataSequential* CDS = nullptr;
     std::string value;
-    if (gvar.hasInitializer()) {
-        value = getInitValue(gvar.getInitializer());
+    //variables of zero size (e.g. zero-length arrays) have nothing to initialize
+    llvm::Type* valueType = gvar.getType()->getElementType();
+    if (gvar.hasInitializer() && (!valueType->isSized() || module->getDataLayout().getTypeAllocSize(valueType) > 0)) {
+        CDS = llvm::dyn_cast<llvm::ConstantDataSequential>(gvar.getInitializer());
+        if (!CDS) {
+            value = getInitValue(gvar.getInitializer());
+        }
     }
 
     llvm::PointerType* PT = llvm::cast<llvm::PointerType>(gvar.getType());
     globalVars.push_back(std::make_unique<GlobalValue>(gvarName, value, getType(PT->getElementType())));
     globalVars.at(globalVars.size() - 1)->getType()->isStatic = gvar.hasInternalLinkage();
+    if (PT->getElementType()->isSized() && gvar.getAlignment() > module->getDataLayout().getABITypeAlignment(PT->getElementType())) {
+        globalVars.at(globalVars.size() - 1)->align = gvar.getAlignment();
+    }
     globalRefs[&gvar] = std::make_unique<RefExpr>(globalVars.at(globalVars.size() - 1).get());
+    if (CDS) {
+        dataInitializers[globalVars.at(globalVars.size() - 1).get()] = CDS;
+    }
 }
 
 std::string Program::getStructVarName() {
@@ -172,60 +569,48 @@ std::string Program::getInitValue(const llvm::Constant* val) {
     }
 
     if (const llvm::ConstantInt* CI = llvm::dyn_cast<llvm::ConstantInt>(val)) {
-        std::string value;
-        if (CI->getBitWidth() > 64) {
-            const llvm::APInt& API = CI->getValue();
-            value = std::to_string(API.getLimitedValue());
-        } else if (CI->getBitWidth() == 1) { //bool in LLVM
-            value = std::to_string(-1 * CI->getSExtValue());
-        } else {
-            value = std::to_string(CI->getSExtValue());
-        }
-
-        return value;
+        return ConstantHandler::getIntegerValue(CI->getValue());
     }
 
     if (const llvm::ConstantFP* CFP = llvm::dyn_cast<llvm::ConstantFP>(val)) {
-        if (CFP->isInfinity()) {
-            return "__builtin_inff ()";
-        }
-
-        if (CFP->isNaN()) {
-            return "__builtin_nanf (\"\")";
-        }
+        return ConstantHandler::getFloatValue(CFP->getValueAPF());
+    }
 
-        std::string ret = std::to_string(CFP->getValueAPF().convertToDouble());
-        if (ret.compare("-nan") == 0) {
-            return "-(__builtin_nanf (\"\"))";
-        }
+    if (const llvm::ConstantDataSequential* CDS = llvm::dyn_cast<llvm::ConstantDataSequential>(val)) {
+        std::ostringstream stream;
+        outputDataSequential(CDS, stream);
+        return stream.str();
+    }
 
-        llvm::SmallVector<char, 32> string;
-        ret = "";
-        CFP->getValueAPF().toString(string, 32, 0);
-        for (unsigned i = 0; i < string.size(); i++) {
-            ret += string[i];
+    if (llvm::isa<llvm::ConstantAggregateZero>(val)) {
+        //zero-length arrays have no element which could be initialized by 0
+        if (module->getDataLayout().getTypeAllocSize(val->getType()) == 0) {
+            return "{}";
         }
-
-        return ret;
+        return "{0}";
     }
 
-    if (const llvm::ConstantDataArray* CDA = llvm::dyn_cast<llvm::ConstantDataArray>(val)) {
+    if (const llvm::ConstantArray* CA = llvm::dyn_cast<llvm::ConstantArray>(val)) {
         std::string value = "{";
         bool first = true;
 
-        for (unsigned i = 0; i < CDA->getNumElements(); i++) {
+        for (unsigned i = 0; i < CA->getNumOperands(); i++) {
             if (!first) {
                 value += ", ";
             }
             first = false;
 
-            value += getInitValue(CDA->getElementAsConstant(i));
+            value += getInitValue(CA->getOperand(i));
         }
 
         return value + "}";
     }
 
     if (const llvm::ConstantStruct* CS = llvm::dyn_cast<llvm::ConstantStruct>(val)) {
+        //padding inserted into the struct is initialized too, so the values stay in their elements
+        std::vector<uint64_t> padding;
+        getStructPadding(CS->getType(), padding);
+
         std::string value = "{";
         bool first = true;
         for (unsigned i = 0; i < CS->getNumOperands(); i++) {
@@ -234,6 +619,9 @@ std::string Program::getInitValue(const llvm::Constant* val) {
             }
             first = false;
 
+            if (!padding.empty() && padding[i] > 0) {
+                value += "{0}, ";
+            }
             value += getInitValue(llvm::cast<llvm::Constant>(val->getOperand(i)));
         }
 
@@ -247,7 +635,86 @@ std::string Program::getInitValue(const llvm::Constant* val) {
     return "{}";
 }
 
+void Program::outputDataSequential(const llvm::ConstantDataSequential* CDS, std::ostream& stream) {
+    std::string chunk;
+    chunk.reserve(OUTPUT_CHUNK_SIZE + 64);
+
+    auto flush = [&chunk, &stream](bool force) {
+        if (force || chunk.size() >= OUTPUT_CHUNK_SIZE) {
+            stream.write(chunk.data(), chunk.size());
+            chunk.clear();
+        }
+    };
+
+    //i8 arrays are output as string literals, trailing zero is added by the compiler
+    if (CDS->isString()) {
+        llvm::StringRef data = CDS->getRawDataValues();
+        if (!data.empty() && data.back() == '\0') {
+            data = data.drop_back();
+        }
+
+        chunk += "\"";
+        for (unsigned i = 0; i < data.size(); i++) {
+            //split long strings into multiple literals, some compilers limit length of one literal
+            if (i != 0 && i % STRING_PIECE_SIZE == 0) {
+                chunk += "\"\n    \"";
+                flush(false);
+            }
+
+            unsigned char c = data[i];
+            switch (c) {
+            case '\n':
+                chunk += "\\n";
+                break;
+            case '\t':
+                chunk += "\\t";
+                break;
+            case '\\':
+                chunk += "\\\\";
+                break;
+            case '"':
+                chunk += "\\\"";
+                break;
+            case '?': //avoids trigraphs
+                chunk += "\\?";
+                break;
+            default:
+                if (c >= 0x20 && c < 0x7f) {
+                    chunk += c;
+                } else {
+                    //octal escape with all three digits, so following digits are not part of the escape
+                    chunk += '\\';
+                    chunk += '0' + ((c >> 6) & 7);
+                    chunk += '0' + ((c >> 3) & 7);
+                    chunk += '0' + (c & 7);
+                }
+            }
+        }
+        chunk += "\"";
+        flush(true);
+        return;
+    }
+
+    chunk += "{";
+    for (unsigned i = 0; i < CDS->getNumElements(); i++) {
+        if (i != 0) {
+            chunk += ",";
+        }
+
+        if (CDS->getElementType()->isIntegerTy()) {
+            chunk += ConstantHandler::getIntegerValue(llvm::APInt(CDS->getElementType()->getIntegerBitWidth(), CDS->getElementAsInteger(i)));
+        } else {
+            chunk += ConstantHandler::getFloatValue(CDS->getElementAsAPFloat(i));
+        }
+        flush(false);
+    }
+    chunk += "}";
+    flush(true);
+}
+
 void Program::unsetAllInit() {
+    declaredLibcFunctions.clear();
+
     for (auto& gvar : globalVars) {
         gvar->init = false;
     }
@@ -255,13 +722,269 @@ void Program::unsetAllInit() {
     for (auto& strct : structs) {
         strct->isPrinted = false;
     }
+
+    for (auto& elem : unnamedStructs) {
+        elem.second->isPrinted = false;
+    }
 }
 
 void Program::print() {
     output(std::cout);
 }
 
+void Program::print(std::ostream& stream) {
+    output(stream);
+}
+
 void Program::saveFile(const std::string& fileName) {
+    if (hasGzipExtension(fileName)) {
+        GzipFileBuffer buffer(fileName);
+        std::ostream file(&buffer);
+        output(file);
+
+        if (!file || !buffer.close()) {
+            throw std::invalid_argument("Output file cannot be written!");
+        }
+    } else {
+        std::ofstream file;
+        file.open(fileName);
+
+        if (!file.is_open()) {
+            throw std::invalid_argument("Output file cannot be opened!");
+        }
+
+        output(file);
+
+        file.close();
+    }
+
+    std::cout << "Translated program successfuly saved into " << fileName << "\n";
+}
+
+void Program::saveIncremental(const std::string& directory) {
+    MemoryReport::Scope memoryScope(MemoryReport::OUTPUT);
+    functionCosts.clear();
+
+    if (llvm::sys::fs::create_directories(directory)) {
+        throw std::invalid_argument("Output directory cannot be created!");
+    }
+
+    //internal symbols are referenced from other files, so they are output with hidden visibility instead
+    splitOutput = true;
+    for (auto& gvar : globalVars) {
+        if (gvar->getType()->isStatic) {
+            gvar->getType()->isStatic = false;
+            gvar->isHidden = true;
+        }
+    }
+
+    std::string oldModuleHash;
+    std::map<std::string, std::string> oldFunctionHashes;
+    readManifest(directory + "/" + MANIFEST_NAME, oldModuleHash, oldFunctionHashes);
+
+    //options of the translation change the output of all functions
+    std::string options = std::string("includes=") + (includes ? "1" : "0") + " casts=" + (noFuncCasts ? "1" : "0") + "\n";
+
+    std::string header = getModuleHeader();
+    std::string moduleHash = getHash(options + header);
+
+    llvm::ModuleSlotTracker slotTracker(module.get());
+    std::set<std::string> usedNames = {HEADER_NAME, GLOBALS_NAME, MANIFEST_NAME};
+    std::vector<std::string> fileNames;
+    std::vector<std::string> functionHashes;
+    std::vector<bool> changed;
+
+    for (const auto& func : functions) {
+        fileNames.push_back(getFunctionFileName(func.first, usedNames));
+        functionHashes.push_back(getFunctionHash(func.first, slotTracker));
+
+        auto it = oldFunctionHashes.find(fileNames.back());
+        changed.push_back(moduleHash != oldModuleHash
+                          || it == oldFunctionHashes.end()
+                          || it->second != functionHashes.back()
+                          || !llvm::sys::fs::exists(directory + "/" + fileNames.back()));
+
+        if (changed.back()) {
+            func.second->parseFunction();
+        }
+    }
+
+    //types and helpers used by functions are created before parsing, header changes only if they were not found
+    std::string newHeader = getModuleHeader();
+    if (newHeader != header) {
+        for (unsigned i = 0; i < functions.size(); i++) {
+            functions.begin()[i].second->parseFunction();
+            changed[i] = true;
+        }
+
+        header = getModuleHeader();
+        moduleHash = getHash(options + header);
+    }
+
+    writeIfChanged(directory + "/" + HEADER_NAME, header);
+
+    //global variables are initialized before function output, so functions use only their names
+    std::ostringstream globals;
+    globals << "#include \"" << HEADER_NAME << "\"\n\n";
+    outputGlobalVars(globals);
+    writeIfChanged(directory + "/" + GLOBALS_NAME, globals.str());
+
+    Trace::Span span("outputFunctions");
+    unsigned written = 0;
+    for (unsigned i = 0; i < functions.size(); i++) {
+        if (!changed[i]) {
+            continue;
+        }
+
+        std::ostringstream file;
+        file << "#include \"" << HEADER_NAME << "\"\n\n";
+        outputFunction(functions.begin()[i].second.get(), file);
+        if (writeIfChanged(directory + "/" + fileNames[i], file.str())) {
+            written++;
+        }
+
+        if (lazy) {
+            functions.begin()[i].second = std::make_unique<Func>(functions.begin()[i].first, this, false);
+        }
+    }
+
+    //files of removed functions
+    for (const auto& elem : oldFunctionHashes) {
+        if (!usedNames.count(elem.first)) {
+            llvm::sys::fs::remove(directory + "/" + elem.first);
+        }
+    }
+
+    std::string manifest = MANIFEST_VERSION + "\nmodule " + moduleHash + "\n";
+    for (unsigned i = 0; i < functions.size(); i++) {
+        manifest += "function " + functionHashes[i] + " " + fileNames[i] + "\n";
+    }
+    writeIfChanged(directory + "/" + MANIFEST_NAME, manifest);
+
+    std::cout << "Translated program successfuly saved into " << directory << " (" << written << " of " << functions.size() << " functions rewritten)\n";
+}
+
+std::string Program::getModuleHeader() {
+    unsetAllInit();
+
+    std::ostringstream stream;
+    stream << "#ifndef LLVM2C_MODULE_H\n";
+    stream << "#define LLVM2C_MODULE_H\n\n";
+    outputPrefix(stream);
+    stream << "#endif\n";
+
+    return stream.str();
+}
+
+std::string Program::getHash(llvm::StringRef data) {
+    llvm::MD5 hash;
+    hash.update(data);
+
+    llvm::MD5::MD5Result result;
+    hash.final(result);
+
+    llvm::SmallString<32> ret;
+    llvm::MD5::stringifyResult(result, ret);
+    return std::string(ret.begin(), ret.end());
+}
+
+std::string Program::getFunctionHash(const llvm::Function* func, llvm::ModuleSlotTracker& slotTracker) {
+    std::string ir;
+    llvm::raw_string_ostream stream(ir);
+
+    stream << func->getName() << " " << func->getLinkage() << " " << func->getAttributes().getAsString(llvm::AttributeList::FunctionIndex) << " ";
+    func->getFunctionType()->print(stream);
+    stream << "\n";
+
+    for (const llvm::BasicBlock& block : *func) {
+        block.printAsOperand(stream, false, slotTracker);
+        stream << ":\n";
+
+        for (const llvm::Instruction& ins : block) {
+            ins.print(stream, slotTracker);
+            stream << "\n";
+
+            //names and types of variables are taken from debug information
+            if (const llvm::DbgDeclareInst* DDI = llvm::dyn_cast<llvm::DbgDeclareInst>(&ins)) {
+                stream << DDI->getVariable()->getName();
+                if (llvm::DIBasicType* type = llvm::dyn_cast_or_null<llvm::DIBasicType>(DDI->getVariable()->getType())) {
+                    stream << " " << type->getName();
+                }
+                stream << "\n";
+            }
+        }
+    }
+    stream.flush();
+
+    //remove numbers of metadata nodes
+    std::string stripped;
+    stripped.reserve(ir.size());
+    for (unsigned i = 0; i < ir.size(); i++) {
+        stripped += ir[i];
+        if (ir[i] == '!') {
+            while (i + 1 < ir.size() && isdigit(ir[i + 1])) {
+                i++;
+            }
+        }
+    }
+
+    return getHash(stripped);
+}
+
+std::string Program::getFunctionFileName(const llvm::Function* func, std::set<std::string>& usedNames) {
+    std::string name = func->getName().str();
+    for (char& c : name) {
+        if (!isalnum(c) && c != '_') {
+            c = '_';
+        }
+    }
+
+    //long names (e.g. mangled C++ names) are shortened, so they do not exceed limits of the file system
+    if (name.size() > 64) {
+        name = name.substr(0, 48) + "_" + getHash(func->getName()).substr(0, 15);
+    }
+
+    std::string fileName = name + ".c";
+    for (unsigned i = 1; usedNames.count(fileName); i++) {
+        fileName = name + "_" + std::to_string(i) + ".c";
+    }
+
+    usedNames.insert(fileName);
+    return fileName;
+}
+
+void Program::readManifest(const std::string& fileName, std::string& moduleHash, std::map<std::string, std::string>& functionHashes) {
+    std::ifstream file(fileName);
+    std::string version;
+    if (!file.is_open() || !(file >> version) || version != MANIFEST_VERSION) {
+        return;
+    }
+
+    std::string kind;
+    std::string hash;
+    while (file >> kind >> hash) {
+        if (kind == "module") {
+            moduleHash = hash;
+        } else if (kind == "function") {
+            std::string name;
+            if (!(file >> name)) {
+                break;
+            }
+
+            //files are only in the output directory
+            if (name.find('/') == std::string::npos) {
+                functionHashes[name] = hash;
+            }
+        }
+    }
+}
+
+bool Program::writeIfChanged(const std::string& fileName, const std::string& content) {
+    auto buffer = llvm::MemoryBuffer::getFile(fileName);
+    if (buffer && (*buffer)->getBuffer() == content) {
+        return false;
+    }
+
     std::ofstream file;
     file.open(fileName);
 
@@ -269,28 +992,27 @@ void Program::saveFile(const std::string& fileName) {
         throw std::invalid_argument("Output file cannot be opened!");
     }
 
-    output(file);
-
+    file << content;
     file.close();
 
-    std::cout << "Translated program successfuly saved into " << fileName << "\n";
+    return true;
 }
 
 void Program::outputStruct(Struct* strct, std::ostream& stream) {
     for (auto& item : strct->items) {
-        if (auto AT = dynamic_cast<ArrayType*>(item.first.get())) {
+        if (auto AT = llvm::dyn_cast<ArrayType>(item.first.get())) {
             if (AT->isStructArray) {
                 outputStruct(getStruct(AT->structName), stream);
             }
         }
 
-        if (auto PT = dynamic_cast<PointerType*>(item.first.get())) {
+        if (auto PT = llvm::dyn_cast<PointerType>(item.first.get())) {
             if (PT->isStructPointer && PT->isArrayPointer) {
                 outputStruct(getStruct(PT->structName), stream);
             }
         }
 
-        if (auto ST = dynamic_cast<StructType*>(item.first.get())) {
+        if (auto ST = llvm::dyn_cast<StructType>(item.first.get())) {
             for (auto& s : structs) {
                 if (s->name == ST->name) {
                     outputStruct(s.get(), stream);
@@ -308,14 +1030,128 @@ void Program::outputStruct(Struct* strct, std::ostream& stream) {
     if (!strct->isPrinted) {
         stream << strct->toString();
         strct->isPrinted = true;
-        stream << "\n\n";
+        stream << "\n";
+        if (layoutAsserts) {
+            stream << strct->layoutAssertsToString();
+        }
+        stream << "\n";
     }
 }
 
 void Program::output(std::ostream &stream) {
+    MemoryReport::Scope memoryScope(MemoryReport::OUTPUT);
+
     unsetAllInit();
+    functionCosts.clear();
+
+    outputPrefix(stream);
+    outputGlobalVars(stream);
+
+    Trace::Span span("outputFunctions");
+    stream << "//Function definitions\n";
+    unsigned typeDefCount = typeHandler.sortedTypeDefs.size();
+    unsigned unnamedStructCount = unnamedStructs.size();
+    for (auto& func : functions) {
+        if (!lazy) {
+            outputFunction(func.second.get(), stream);
+            continue;
+        }
+
+        func.second->parseFunction();
+        outputNewTypes(stream, typeDefCount, unnamedStructCount);
+        outputFunction(func.second.get(), stream);
+
+        //parsed function is replaced by unparsed one, so only one parsed function is kept in memory
+        func.second = std::make_unique<Func>(func.first, this, false);
+    }
+}
+
+void Program::outputFunction(Func* func, std::ostream& stream) {
+    if (!costReport) {
+        func->output(stream);
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::ostringstream functionStream;
+    func->output(functionStream);
+    std::string output = functionStream.str();
+    stream << output;
+
+    FunctionCost cost;
+    cost.name = func->function->getName().str();
+    if (const llvm::DISubprogram* SP = func->function->getSubprogram()) {
+        cost.location = SP->getFilename().str() + ":" + std::to_string(SP->getLine());
+    }
+    cost.instructions = 0;
+    for (const llvm::BasicBlock& block : *func->function) {
+        cost.instructions += block.size();
+    }
+    cost.time = func->parseTime + std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    cost.bytes = output.size();
+    cost.exprs = func->exprCount;
+    cost.temporaries = func->temporaryCount;
+    functionCosts.push_back(cost);
+}
+
+void Program::printCostReport(std::ostream& stream, unsigned count) const {
+    struct Ranking {
+        const char* title;
+        std::function<bool(const FunctionCost&, const FunctionCost&)> compare;
+    };
+
+    const Ranking rankings[] = {
+        {"translation time", [](const FunctionCost& a, const FunctionCost& b) { return a.time > b.time; }},
+        {"output size", [](const FunctionCost& a, const FunctionCost& b) { return a.bytes > b.bytes; }},
+        {"expressions", [](const FunctionCost& a, const FunctionCost& b) { return a.exprs > b.exprs; }},
+        {"temporaries", [](const FunctionCost& a, const FunctionCost& b) { return a.temporaries > b.temporaries; }},
+        {"expansion ratio", [](const FunctionCost& a, const FunctionCost& b) { return a.getExpansion() > b.getExpansion(); }},
+    };
+
+    std::vector<const FunctionCost*> costs;
+    for (const auto& cost : functionCosts) {
+        costs.push_back(&cost);
+    }
+
+    for (const auto& ranking : rankings) {
+        unsigned size = std::min<std::size_t>(count, costs.size());
+        std::partial_sort(costs.begin(), costs.begin() + size, costs.end(), [&ranking](const FunctionCost* a, const FunctionCost* b) {
+            return ranking.compare(*a, *b);
+        });
+
+        stream << "Top " << size << " functions by " << ranking.title << ":\n";
+        for (unsigned i = 0; i < size; i++) {
+            const FunctionCost* cost = costs[i];
+            stream << "  " << i + 1 << ". " << cost->name;
+            if (!cost->location.empty()) {
+                stream << " (" << cost->location << ")";
+            }
+            stream << ": " << cost->time * 1000 << " ms, " << cost->bytes << " bytes, " << cost->instructions << " instructions, "
+                   << cost->exprs << " expressions, " << cost->temporaries << " temporaries, " << cost->getExpansion() << " bytes/instruction\n";
+        }
+        stream << "\n";
+    }
+}
+
+void Program::outputNewTypes(std::ostream& stream, unsigned& typeDefCount, unsigned& unnamedStructCount) {
+    for (; typeDefCount < typeHandler.sortedTypeDefs.size(); typeDefCount++) {
+        stream << typeHandler.sortedTypeDefs[typeDefCount]->defToString() << "\n\n";
+    }
+
+    for (; unnamedStructCount < unnamedStructs.size(); unnamedStructCount++) {
+        Struct* strct = unnamedStructs.begin()[unnamedStructCount].second.get();
+        stream << "struct " << strct->name << ";\n";
+        if (!strct->isPrinted) {
+            outputStruct(strct, stream);
+        }
+    }
+}
+
+void Program::outputPrefix(std::ostream& stream) {
+    Trace::Span span("outputPrefix");
 
     stream << getIncludeString();
+    stream << getHelperString();
 
     if (!structs.empty()) {
         stream << "//Struct declarations\n";
@@ -358,6 +1194,10 @@ void Program::output(std::ostream &stream) {
                 continue;
             }
 
+            //split program defines global variables in a different file
+            if (splitOutput) {
+                stream << "extern ";
+            }
             stream << gvar->declToString();
             stream << "\n";
         }
@@ -381,6 +1221,10 @@ void Program::output(std::ostream &stream) {
         }
         stream << "\n";
     }
+}
+
+void Program::outputGlobalVars(std::ostream& stream) {
+    Trace::Span span("outputGlobalVars");
 
     if (!globalVars.empty()) {
         stream << "//Global variable definitions\n";
@@ -390,17 +1234,19 @@ void Program::output(std::ostream &stream) {
                 continue;
             }
 
-            stream << gvar->toString();
+            auto it = dataInitializers.find(gvar.get());
+            if (it != dataInitializers.end()) {
+                stream << gvar->definitionToString() << " = ";
+                outputDataSequential(it->second, stream);
+                stream << ";";
+            } else {
+                stream << gvar->toString();
+            }
             gvar->init = true;
             stream << "\n";
         }
         stream << "\n";
     }
-
-    stream << "//Function definitions\n";
-    for (const auto& func : functions) {
-        func.second->output(stream);
-    }
 }
 
 Struct* Program::getStruct(const llvm::StructType* strct) const {
@@ -445,9 +1291,10 @@ RefExpr* Program::getGlobalVar(const llvm::Value* val) {
     return nullptr;
 }
 
-void Program::addDeclaration(llvm::Function* func) {
+void Program::addDeclaration(const llvm::Function* func) {
     if (!declarations.count(func)) {
-        declarations[func] = std::make_unique<Func>(func, this, true);
+        auto declaration = std::make_unique<Func>(func, this, true);
+        declarations[func] = std::move(declaration);
     }
 }
 
@@ -462,9 +1309,89 @@ void Program::createNewUnnamedStruct(const llvm::StructType *strct) {
         structExpr->addItem(getType(type), getStructVarName());
     }
 
+    setStructLayout(structExpr.get(), strct);
     unnamedStructs[strct] = std::move(structExpr);
 }
 
+void Program::setStructLayout(Struct* structExpr, const llvm::StructType* structType) {
+    if (structType->isOpaque() || !structType->isSized()) {
+        return;
+    }
+
+    const llvm::DataLayout& layout = module->getDataLayout();
+    const llvm::StructLayout* structLayout = layout.getStructLayout(const_cast<llvm::StructType*>(structType));
+    uint64_t structAlignment = layout.getABITypeAlignment(const_cast<llvm::StructType*>(structType));
+
+    structExpr->hasLayout = true;
+    structExpr->size = structLayout->getSizeInBytes();
+    for (unsigned i = 0; i < structType->getNumElements(); i++) {
+        structExpr->offsets.push_back(structLayout->getElementOffset(i));
+    }
+
+    structExpr->isPacked = getStructPadding(structType, structExpr->padding);
+    if (structExpr->isPacked && !structType->isPacked() && structAlignment > 1) {
+        structExpr->alignment = structAlignment;
+    }
+}
+
+bool Program::getStructPadding(const llvm::StructType* structType, std::vector<uint64_t>& padding) const {
+    if (structType->isOpaque() || !structType->isSized()) {
+        return false;
+    }
+
+    const llvm::DataLayout& layout = module->getDataLayout();
+    const llvm::StructLayout* structLayout = layout.getStructLayout(const_cast<llvm::StructType*>(structType));
+    uint64_t structAlignment = layout.getABITypeAlignment(const_cast<llvm::StructType*>(structType));
+
+    //offsets of the C struct without any attributes
+    bool natural = !structType->isPacked();
+    uint64_t offset = 0;
+    uint64_t alignment = 1;
+    for (unsigned i = 0; i < structType->getNumElements() && natural; i++) {
+        llvm::Type* type = structType->getElementType(i);
+        uint64_t elementAlignment = getCAlignment(type);
+        alignment = std::max(alignment, elementAlignment);
+        offset = llvm::alignTo(offset, elementAlignment);
+        if (offset != structLayout->getElementOffset(i)) {
+            natural = false;
+        }
+        offset += layout.getTypeAllocSize(type);
+    }
+
+    if (natural && alignment == structAlignment && llvm::alignTo(offset, alignment) == structLayout->getSizeInBytes()) {
+        return false;
+    }
+
+    //packed struct keeps offsets from the DataLayout, gaps are filled by padding
+    offset = 0;
+    for (unsigned i = 0; i < structType->getNumElements(); i++) {
+        uint64_t elementOffset = structLayout->getElementOffset(i);
+        if (elementOffset > offset) {
+            padding.resize(structType->getNumElements());
+            padding[i] = elementOffset - offset;
+        }
+        offset = elementOffset + layout.getTypeAllocSize(structType->getElementType(i));
+    }
+
+    return true;
+}
+
+uint64_t Program::getCAlignment(llvm::Type* type) const {
+    const llvm::DataLayout& layout = module->getDataLayout();
+
+    if (auto AT = llvm::dyn_cast<llvm::ArrayType>(type)) {
+        return getCAlignment(AT->getElementType());
+    }
+
+    //__int128 is aligned to 16 bytes by C compilers, while older DataLayouts align i128 only to 8 bytes;
+    //structs are aligned as in the DataLayout, because they are packed otherwise
+    if (type->isIntegerTy() && type->getIntegerBitWidth() > 64) {
+        return std::max<uint64_t>(layout.getABITypeAlignment(type), 16);
+    }
+
+    return layout.getABITypeAlignment(type);
+}
+
 std::unique_ptr<Type> Program::getType(const llvm::Type* type) {
     return typeHandler.getType(type);
 }
@@ -476,20 +1403,62 @@ std::string Program::getIncludeString() const {
         ret += "#include <stdarg.h>\n";
     }
 
-    if (hasStdLib) {
-        ret += "#include <stdlib.h>\n";
+    for (unsigned header = 0; header < static_cast<unsigned>(LibcHeader::COUNT); header++) {
+        if (libcHeaders & (1u << header)) {
+            ret += "#include <";
+            ret += getLibcHeaderName(static_cast<LibcHeader>(header));
+            ret += ">\n";
+        }
     }
 
-    if (hasString) {
-        ret += "#include <string.h>\n";
+    if (!ret.empty()) {
+        ret += "\n";
     }
 
-    if (hasStdio) {
-        ret += "#include <stdio.h>\n";
+    return ret;
+}
+
+std::string Program::getHelperString() const {
+    std::string ret;
+
+    if (hasMustTail) {
+        //LLVM2C_NO_MUSTTAIL selects the portable variant even if the attribute is supported
+        ret += "#if defined(__has_attribute) && !defined(LLVM2C_NO_MUSTTAIL)\n";
+        ret += "#if __has_attribute(musttail)\n";
+        ret += "#define LLVM2C_MUSTTAIL __attribute__((musttail))\n";
+        ret += "#define LLVM2C_MUSTTAIL_VOID(...) LLVM2C_MUSTTAIL return __VA_ARGS__\n";
+        ret += "#endif\n";
+        ret += "#endif\n";
+        ret += "#ifndef LLVM2C_MUSTTAIL\n";
+        ret += "#define LLVM2C_MUSTTAIL\n";
+        ret += "#define LLVM2C_MUSTTAIL_VOID(...) __VA_ARGS__; return\n";
+        ret += "#endif\n";
     }
 
-    if (hasPthread) {
-        ret += "#include <pthread.h>\n";
+    if (hasVolatileMem) {
+        if (!ret.empty()) {
+            ret += "\n";
+        }
+
+        ret += "static inline void llvm2c_volatile_memmove(volatile void* dest, const volatile void* src, unsigned long n) {\n";
+        ret += "    volatile unsigned char* d = dest;\n";
+        ret += "    const volatile unsigned char* s = src;\n";
+        ret += "    if (d < s) {\n";
+        ret += "        while (n--) {\n";
+        ret += "            *d++ = *s++;\n";
+        ret += "        }\n";
+        ret += "    } else {\n";
+        ret += "        while (n--) {\n";
+        ret += "            d[n] = s[n];\n";
+        ret += "        }\n";
+        ret += "    }\n";
+        ret += "}\n\n";
+        ret += "static inline void llvm2c_volatile_memset(volatile void* dest, int c, unsigned long n) {\n";
+        ret += "    volatile unsigned char* d = dest;\n";
+        ret += "    while (n--) {\n";
+        ret += "        *d++ = (unsigned char)c;\n";
+        ret += "    }\n";
+        ret += "}\n";
     }
 
     if (!ret.empty()) {
@@ -2,12 +2,19 @@
 
 #include <vector>
 #include <set>
+#include <map>
 
 #include <llvm/Support/SourceMgr.h>
 #include <llvm/IR/Module.h>
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/MapVector.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/IR/ModuleSlotTracker.h"
 
 #include "Func.h"
+#include "NameService.h"
+#include "ConstantHandler.h"
 #include "../expr/Expr.h"
 #include "../type/TypeHandler.h"
 
@@ -16,6 +23,7 @@
  */
 class Program {
 friend class TypeHandler;
+friend class ConstantHandler;
 friend class Func;
 private:
     llvm::LLVMContext context;
@@ -23,17 +31,42 @@ private:
     std::unique_ptr<llvm::Module> module;
 
     TypeHandler typeHandler;
+    ConstantHandler constantHandler;
 
     //expressions
-    llvm::DenseMap<const llvm::Function*, std::unique_ptr<Func>> functions; //map containing function definitions
-    llvm::DenseMap<const llvm::Function*, std::unique_ptr<Func>> declarations; //map containing function declarations
+    //maps are iterated in insertion order, so the output does not depend on addresses of LLVM objects
+    llvm::MapVector<const llvm::Function*, std::unique_ptr<Func>> functions; //map containing function definitions
+    llvm::MapVector<const llvm::Function*, std::unique_ptr<Func>> declarations; //map containing function declarations
     std::vector<std::unique_ptr<Struct>> structs; // vector of parsed structs
     std::vector<std::unique_ptr<GlobalValue>> globalVars; // vector of parsed global variables
     llvm::DenseMap<const llvm::GlobalVariable*, std::unique_ptr<RefExpr>> globalRefs; //map containing references to global variables
-    llvm::DenseMap<const llvm::StructType*, std::unique_ptr<Struct>> unnamedStructs; // map containing unnamed structs
+    llvm::MapVector<const llvm::StructType*, std::unique_ptr<Struct>> unnamedStructs; // map containing unnamed structs
+    llvm::DenseMap<const GlobalValue*, const llvm::ConstantDataSequential*> dataInitializers; //map containing initializers of global variables that are output directly from LLVM data
 
-    //set containing names of global variables that are in "var[0-9]+" format, used in creating variable names in functions
-    std::set<std::string> globalVarNames;
+    //names of global variables reserved for all functions, used in creating variable names in functions
+    NameService globalNames;
+
+    /**
+     * @brief The FunctionCost struct contains costs of translation of one function, used in cost report.
+     */
+    struct FunctionCost {
+        std::string name;
+        std::string location; //source location from debug information, empty if not present
+        unsigned instructions; //number of LLVM instructions
+        double time; //time of parsing and output in seconds
+        std::size_t bytes; //size of the output in bytes
+        std::size_t exprs; //number of Expr nodes
+        unsigned temporaries; //number of variables created by parsing
+
+        double getExpansion() const {
+            return instructions ? static_cast<double>(bytes) / instructions : 0;
+        }
+    };
+
+    std::vector<FunctionCost> functionCosts; //costs of output functions, collected only if costReport is set
+
+    static const unsigned OUTPUT_CHUNK_SIZE = 64 * 1024; //size of chunks used for output of large initializers
+    static const unsigned STRING_PIECE_SIZE = 64; //maximal length of one piece of string literal
 
     //variables used for creating names for structs and anonymous structs
     unsigned structVarCount = 0;
@@ -45,6 +78,29 @@ private:
      */
     std::string getStructVarName();
 
+    /**
+     * @brief setStructLayout Sets layout of the struct from the DataLayout. If the natural layout of the C struct
+     * would differ (or the struct is packed in the module), the struct is packed and padding is inserted.
+     * @param structExpr Translated struct
+     * @param structType LLVM struct type
+     */
+    void setStructLayout(Struct* structExpr, const llvm::StructType* structType);
+
+    /**
+     * @brief getStructPadding Computes padding of the struct, which is needed when the struct is packed.
+     * @param structType LLVM struct type
+     * @param padding Bytes of padding before every element, empty if no padding is needed
+     * @return True if the struct has to be packed to keep the layout from the DataLayout, false otherwise
+     */
+    bool getStructPadding(const llvm::StructType* structType, std::vector<uint64_t>& padding) const;
+
+    /**
+     * @brief getCAlignment Returns alignment of the type in the translated program.
+     * @param type LLVM type
+     * @return Alignment in bytes
+     */
+    uint64_t getCAlignment(llvm::Type* type) const;
+
     /**
      * @brief getAnonStructName Creates new name for anonymous struct.
      * @return New name for anonymous struct
@@ -58,6 +114,14 @@ private:
      */
     std::string getInitValue(const llvm::Constant* val);
 
+    /**
+     * @brief outputDataSequential Outputs initializer of LLVM data array or vector to given stream in chunks.
+     * i8 arrays are output as string literals, other arrays as lists of numbers.
+     * @param CDS LLVM ConstantDataSequential
+     * @param stream Stream for output
+     */
+    static void outputDataSequential(const llvm::ConstantDataSequential* CDS, std::ostream& stream);
+
     /**
      * @brief unsetAllInit Resets the init flag for every global variable.
      * Used for repeated calling of print and saveFile.
@@ -77,6 +141,43 @@ private:
      */
     void printStruct(Struct* strct);
 
+    /**
+     * @brief loadFile Parses LLVM IR or bitcode file, or members of a bitcode archive, and links them into the module.
+     * @param file Path to the file
+     */
+    void loadFile(const std::string& file);
+
+    /**
+     * @brief loadBuffer Parses LLVM IR or bitcode, or members of a bitcode archive, and links them into the module.
+     * The buffer can be gzip compressed. All members of an archive are linked if it is the first input, otherwise only members
+     * defining symbols undefined in the module (and recursively in the linked members) are linked, like from a static library.
+     * @param buffer Content of the input, its identifier is used in error messages
+     */
+    void loadBuffer(llvm::MemoryBufferRef buffer);
+
+    /**
+     * @brief linkModule Links the module into the module of the program. Types and declarations shared by the modules
+     * are merged by the linker, so they are translated only once.
+     * @param linked Module to link, it becomes the module of the program if there is none yet
+     * @param name Name of the linked file used in error messages
+     */
+    void linkModule(std::unique_ptr<llvm::Module> linked, const std::string& name);
+
+    /**
+     * @brief definesUndefinedSymbol Checks whether the archive member defines a symbol that is only declared in the module.
+     * @param member Parsed archive member
+     * @return True if linking the member resolves an undefined symbol, false otherwise
+     */
+    bool definesUndefinedSymbol(const llvm::Module& member) const;
+
+    /**
+     * @brief eliminateDeadCode Removes functions, global variables, aliases and declarations from the module that are not reachable
+     * from the roots, so they are never translated. Structs and typedefs used only by removed symbols are not output, as they are
+     * no longer found in the module.
+     * @param roots Names of root symbols, all externally visible definitions are roots if empty
+     */
+    void eliminateDeadCode(const std::vector<std::string>& roots);
+
     /**
      * @brief parseProgram Parses the whole program (structs, functions and global variables).
      */
@@ -87,6 +188,28 @@ private:
      */
     void parseStructs();
 
+    /**
+     * @brief parseFunctionTypes Creates types used in bodies of functions (typedefs and unnamed structs) in module order
+     * and sets flags of helpers used by the bodies. Output of the program before function definitions
+     * therefore does not depend on which functions are parsed and in which order.
+     */
+    void parseFunctionTypes();
+
+    /**
+     * @brief parseConstantTypes Creates types of the constant and of all its operands.
+     * @param constant LLVM Constant
+     * @param visited Set of constants whose types are already created
+     * @param types Set of types that are already created
+     */
+    void parseConstantTypes(const llvm::Constant* constant, llvm::DenseSet<const llvm::Constant*>& visited, llvm::DenseSet<const llvm::Type*>& types);
+
+    /**
+     * @brief parseTypeOnce Creates the type if it is not in the set of created types yet.
+     * @param type LLVM Type
+     * @param types Set of types that are already created
+     */
+    void parseTypeOnce(const llvm::Type* type, llvm::DenseSet<const llvm::Type*>& types);
+
     /**
      * @brief parseFunctions Parses functions into corresponding expressions.
      */
@@ -109,12 +232,93 @@ private:
      */
     std::string getIncludeString() const;
 
+    /**
+     * @brief getHelperString Returns string containing helper macros and functions program uses.
+     * @return String containing helper macros and functions
+     */
+    std::string getHelperString() const;
+
     /**
      * @brief output Outputs the translated program to given stream.
      * @param stream Stream for output
      */
     void output(std::ostream& stream);
 
+    /**
+     * @brief outputFunction Outputs the function to given stream. If costReport is set, costs of the function are collected.
+     * @param func Function for output
+     * @param stream Stream for output
+     */
+    void outputFunction(Func* func, std::ostream& stream);
+
+    /**
+     * @brief outputNewTypes Outputs typedefs and unnamed structs that were created after the given counts of them were output.
+     * Types used by functions are created before parsing, so this is needed only if some type was not found in advance.
+     * @param stream Stream for output
+     * @param typeDefCount Number of typedefs that are already output, updated after output
+     * @param unnamedStructCount Number of unnamed structs that are already output, updated after output
+     */
+    void outputNewTypes(std::ostream& stream, unsigned& typeDefCount, unsigned& unnamedStructCount);
+
+    /**
+     * @brief outputPrefix Outputs everything that precedes definitions of global variables and functions
+     * (includes, helpers, structs, typedefs and declarations) to given stream.
+     * @param stream Stream for output
+     */
+    void outputPrefix(std::ostream& stream);
+
+    /**
+     * @brief outputGlobalVars Outputs definitions of global variables to given stream.
+     * @param stream Stream for output
+     */
+    void outputGlobalVars(std::ostream& stream);
+
+    /**
+     * @brief getModuleHeader Returns content of the header shared by all files of the split program.
+     * @return String containing the header
+     */
+    std::string getModuleHeader();
+
+    /**
+     * @brief getHash Returns MD5 hash of given data.
+     * @param data Hashed data
+     * @return String containing hexadecimal hash
+     */
+    static std::string getHash(llvm::StringRef data);
+
+    /**
+     * @brief getFunctionHash Returns hash of the IR of the function. Numbers of metadata nodes are not hashed,
+     * as they change with the rest of the module, debug information used in translation is hashed instead.
+     * @param func LLVM Function
+     * @param slotTracker Slot tracker of the module, used for fast printing of instructions
+     * @return String containing hexadecimal hash
+     */
+    static std::string getFunctionHash(const llvm::Function* func, llvm::ModuleSlotTracker& slotTracker);
+
+    /**
+     * @brief getFunctionFileName Returns unique name of the file containing definition of the function.
+     * @param func LLVM Function
+     * @param usedNames Names of files that are already used, the new name is inserted into the set
+     * @return Name of the file
+     */
+    static std::string getFunctionFileName(const llvm::Function* func, std::set<std::string>& usedNames);
+
+    /**
+     * @brief readManifest Reads manifest of the previous incremental translation. Missing or invalid manifest is treated as empty.
+     * @param fileName Name of the manifest file
+     * @param moduleHash Hash of the module header from the manifest
+     * @param functionHashes Map of function file names to hashes of the functions from the manifest
+     */
+    static void readManifest(const std::string& fileName, std::string& moduleHash, std::map<std::string, std::string>& functionHashes);
+
+    /**
+     * @brief writeIfChanged Writes content to the file only if the file does not already contain it, so the time of last modification is kept.
+     * @param fileName Name of the file
+     * @param content Content of the file
+     * @return True if the file was written, false otherwise
+     */
+    static bool writeIfChanged(const std::string& fileName, const std::string& content);
+
     /**
      * @brief outputStruct Outputs parsed Struct to given stream. If Struct contains other Struct, then the other is output first.
      * @param strct Struct for output
@@ -126,33 +330,88 @@ public:
     bool stackIgnored = false; //instruction stacksave was ignored
 
     bool hasVarArg = false; //program uses "stdarg.h"
-    bool hasStdLib = false; //program uses "stdlib.h"
-    bool hasString = false; //program uses "string.h"
-    bool hasStdio = false; //program uses "stdio.h"
-    bool hasPthread = false; //program uses "pthread.h"
+    unsigned libcHeaders = 0; //bitmask of LibcHeader values of headers declaring used library functions, only with includes
+    llvm::DenseSet<const LibcFunction*> declaredLibcFunctions; //library functions whose canonical prototype was already output
+
+    bool hasMustTail = false; //program uses calls that must be tail calls
+    bool hasVolatileMem = false; //program uses volatile memcpy, memmove or memset
+
+    //inline asm is uniqued by LLVM, so its constraints are parsed only once for all calls
+    llvm::DenseMap<const llvm::InlineAsm*, ParsedAsm> parsedAsm;
 
     bool includes; //program uses includes instead of declarations for standard library functions, for testing purposes only
     bool noFuncCasts; //program removes any function call casts, for testing purposes only
+    bool lazy; //bodies of functions are parsed only when they are needed for output, output functions are released immediately
+
+    bool splitOutput = false; //program is output into multiple files, internal symbols are output with hidden visibility instead of static
+    bool costReport = false; //costs of translation of functions are collected during output
+    bool layoutAsserts = false; //sizes of structs and offsets of their elements are checked by static assertions
 
     /**
      * @brief Program Constructor of a Program class, parses given file into a llvm::Module.
      * @param file Path to a file for parsing.
      * @param includes Program uses includes instead of declarations.
      * @param casts Program removes function call casts.
+     * @param lazy Bodies of functions are parsed only when they are needed for output and released after it,
+     * so only one parsed function is kept in memory.
+     */
+    Program(const std::string& file, bool includes, bool casts, bool lazy = false);
+
+    /**
+     * @brief Program Constructor of a Program class, parses given files (LLVM IR, bitcode or archives of bitcode files)
+     * and links them into one llvm::Module, which is translated as a whole program.
+     * @param files Paths to files for parsing.
+     * @param includes Program uses includes instead of declarations.
+     * @param casts Program removes function call casts.
+     * @param lazy Bodies of functions are parsed only when they are needed for output and released after it.
+     * @param eliminateDead Symbols unreachable from the roots are removed before translation.
+     * @param roots Names of root symbols for elimination of dead symbols, all externally visible definitions are roots if empty.
+     */
+    Program(const std::vector<std::string>& files, bool includes, bool casts, bool lazy = false, bool eliminateDead = false,
+            const std::vector<std::string>& roots = std::vector<std::string>());
+
+    /**
+     * @brief Program Constructor of a Program class, parses LLVM IR or bitcode in given buffer into a llvm::Module.
+     * @param buffer Buffer containing the module, it has to be null terminated if it contains IR.
+     * @param includes Program uses includes instead of declarations.
+     * @param casts Program removes function call casts.
+     * @param lazy Bodies of functions are parsed only when they are needed for output and released after it.
      */
-    Program(const std::string& file, bool includes, bool casts);
+    Program(llvm::MemoryBufferRef buffer, bool includes, bool casts, bool lazy = false);
 
     /**
      * @brief print Prints the translated program in the llvm::outs() stream.
      */
     void print();
 
+    /**
+     * @brief print Prints the translated program in given stream.
+     * @param stream Stream for output
+     */
+    void print(std::ostream& stream);
+
     /**
      * @brief saveFile Saves the translated program to the file with given name.
      * @param fileName Name of the file.
      */
     void saveFile(const std::string& fileName);
 
+    /**
+     * @brief saveIncremental Saves the translated program into the directory, split into a header, a file with global variables
+     * and one file per function. Manifest with hashes of the functions is saved with the files. If the directory contains output
+     * of previous translation, only functions whose IR or module header changed are parsed and output, other files are not touched.
+     * @param directory Name of the output directory
+     */
+    void saveIncremental(const std::string& directory);
+
+    /**
+     * @brief printCostReport Prints functions with the highest costs of translation (time, output size, number of expressions
+     * and output bytes per LLVM instruction). Costs are collected during output only if costReport is set.
+     * @param stream Stream for output
+     * @param count Number of functions printed in every category
+     */
+    void printCostReport(std::ostream& stream, unsigned count) const;
+
     /**
      * @brief getStruct Returns pointer to the Struct corresponding to the given LLVM StructType.
      * @param strct LLVM StructType
@@ -178,7 +437,7 @@ public:
      * @brief addDeclaration Adds new declaration of given function.
      * @param func LLVM Function
      */
-    void addDeclaration(llvm::Function* func);
+    void addDeclaration(const llvm::Function* func);
 
     /**
      * @brief createNewUnnamedStruct Adds new unnamed struct to the unnamedStructs map.
@@ -0,0 +1,92 @@
+#include "Trace.h"
+
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+bool Trace::enabled = false;
+unsigned Trace::blockThreshold = 1000;
+std::vector<Trace::Event> Trace::events;
+std::mutex Trace::eventsMutex;
+unsigned Trace::threadCount = 0;
+const std::chrono::steady_clock::time_point Trace::programStart = std::chrono::steady_clock::now();
+
+void Trace::Saver::save() {
+    if (enabled && !saved) {
+        saved = true;
+        Trace::save(fileName);
+    }
+}
+
+Trace::Saver::~Saver() {
+    try {
+        save();
+    } catch (std::invalid_argument& e) {
+        std::cerr << e.what() << "\n";
+    }
+}
+
+void Trace::addEvent(const char* name, const std::string& detail, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+    //threads are numbered in order of their first event, 0 means that the thread has no number yet
+    static thread_local unsigned threadId = 0;
+
+    std::lock_guard<std::mutex> lock(eventsMutex);
+    if (threadId == 0) {
+        threadId = ++threadCount;
+    }
+
+    events.push_back({name,
+                      detail,
+                      static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(start - programStart).count()),
+                      static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()),
+                      threadId});
+}
+
+std::string Trace::escape(const std::string& str) {
+    std::string ret;
+    for (char c : str) {
+        switch (c) {
+        case '"':
+            ret += "\\\"";
+            break;
+        case '\\':
+            ret += "\\\\";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                const char* digits = "0123456789abcdef";
+                ret += "\\u00";
+                ret += digits[(c >> 4) & 0xf];
+                ret += digits[c & 0xf];
+            } else {
+                ret += c;
+            }
+        }
+    }
+
+    return ret;
+}
+
+void Trace::save(const std::string& fileName) {
+    std::ofstream file;
+    file.open(fileName);
+
+    if (!file.is_open()) {
+        throw std::invalid_argument("Trace file cannot be opened!");
+    }
+
+    std::lock_guard<std::mutex> lock(eventsMutex);
+    file << "{\"traceEvents\": [\n";
+    file << "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": {\"name\": \"llvm2c\"}}";
+    for (const auto& event : events) {
+        file << ",\n{\"name\": \"" << event.name << "\", \"cat\": \"llvm2c\", \"ph\": \"X\", \"ts\": " << event.begin
+             << ", \"dur\": " << event.duration << ", \"pid\": 1, \"tid\": " << event.threadId;
+        if (!event.detail.empty()) {
+            file << ", \"args\": {\"detail\": \"" << escape(event.detail) << "\"}";
+        }
+        file << "}";
+    }
+    file << "\n]}\n";
+
+    file.close();
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "llvm/ADT/StringRef.h"
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The Trace class collects spans of the translation (parsing of the module, functions and large blocks, output sections)
+ * and saves them as Chrome trace events, which can be loaded into chrome://tracing or Perfetto.
+ * All members are static, spans are recorded by Trace::Span from any thread.
+ */
+class Trace {
+public:
+    /**
+     * @brief The Span class records the time between its construction and destruction as one complete trace event.
+     */
+    class Span {
+    private:
+        const char* name;
+        std::string detail;
+        std::chrono::steady_clock::time_point start;
+
+    public:
+        /**
+         * @brief Span Starts the span if tracing is enabled.
+         * @param name Name of the span, has to be a string literal
+         * @param detail Detail of the span (e.g. name of the function), copied only if tracing is enabled
+         */
+        Span(const char* name, llvm::StringRef detail = "")
+            : name(name) {
+            if (enabled) {
+                this->detail = detail.str();
+                start = std::chrono::steady_clock::now();
+            }
+        }
+
+        ~Span() {
+            if (enabled) {
+                addEvent(name, detail, start, std::chrono::steady_clock::now());
+            }
+        }
+    };
+
+    /**
+     * @brief The Saver class saves the trace when it is destroyed, so the trace is saved even if the translation fails.
+     */
+    class Saver {
+    private:
+        std::string fileName;
+        bool saved = false;
+
+    public:
+        Saver(const std::string& fileName)
+            : fileName(fileName) { }
+
+        /**
+         * @brief save Saves the trace if tracing is enabled. Throws std::invalid_argument if the file cannot be opened.
+         */
+        void save();
+
+        /**
+         * @brief ~Saver Saves the trace if it was not saved yet, errors are printed to the standard error output.
+         */
+        ~Saver();
+    };
+
+    static bool enabled; //spans are recorded only if tracing is enabled
+    static unsigned blockThreshold; //minimal number of instructions of a block whose parsing is traced
+
+    /**
+     * @brief save Saves recorded events into the file in Chrome trace event format.
+     * @param fileName Name of the file
+     */
+    static void save(const std::string& fileName);
+
+private:
+    struct Event {
+        const char* name;
+        std::string detail;
+        std::uint64_t begin; //microseconds since the start of the program
+        std::uint64_t duration; //microseconds
+        unsigned threadId;
+    };
+
+    static std::vector<Event> events;
+    static std::mutex eventsMutex;
+    static unsigned threadCount;
+    static const std::chrono::steady_clock::time_point programStart;
+
+    /**
+     * @brief addEvent Adds complete event to the recorded events.
+     * @param name Name of the event
+     * @param detail Detail of the event
+     * @param start Start of the event
+     * @param end End of the event
+     */
+    static void addEvent(const char* name, const std::string& detail, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+
+    /**
+     * @brief escape Escapes string for use in JSON string.
+     * @param str String for escaping
+     * @return Escaped string
+     */
+    static std::string escape(const std::string& str);
+};
@@ -8,7 +8,8 @@
  * BinaryExpr classes
  */
 
-BinaryExpr::BinaryExpr(Expr* l, Expr* r) {
+BinaryExpr::BinaryExpr(ExprKind kind, Expr* l, Expr* r)
+    : ExprBase(kind) {
     left = l;
     right = r;
 
@@ -16,7 +17,7 @@ BinaryExpr::BinaryExpr(Expr* l, Expr* r) {
 }
 
 AddExpr::AddExpr(Expr* l, Expr* r) :
-    BinaryExpr(l, r) { }
+    BinaryExpr(EK_Add, l, r) { }
 
 void AddExpr::print() const {
     llvm::outs() << toString();
@@ -27,7 +28,7 @@ std::string AddExpr::toString() const {
 }
 
 SubExpr::SubExpr(Expr* l, Expr* r) :
-    BinaryExpr(l, r) { }
+    BinaryExpr(EK_Sub, l, r) { }
 
 void SubExpr::print() const {
     llvm::outs() << toString();
@@ -38,7 +39,7 @@ std::string SubExpr::toString() const {
 }
 
 AssignExpr::AssignExpr(Expr* l, Expr* r) :
-    BinaryExpr(l, r) { }
+    BinaryExpr(EK_Assign, l, r) { }
 
 void AssignExpr::print() const {
     llvm::outs() << toString();
@@ -49,7 +50,7 @@ std::string AssignExpr::toString() const {
 }
 
 MulExpr::MulExpr(Expr* l, Expr* r) :
-    BinaryExpr(l, r) { }
+    BinaryExpr(EK_Mul, l, r) { }
 
 void MulExpr::print() const {
     llvm::outs() << toString();
@@ -60,7 +61,7 @@ std::string MulExpr::toString() const {
 }
 
 DivExpr::DivExpr(Expr* l, Expr* r) :
-    BinaryExpr(l, r) { }
+    BinaryExpr(EK_Div, l, r) { }
 
 void DivExpr::print() const {
     llvm::outs() << toString();
@@ -71,7 +72,7 @@ std::string DivExpr::toString() const {
 }
 
 RemExpr::RemExpr(Expr* l, Expr* r) :
-    BinaryExpr(l, r) { }
+    BinaryExpr(EK_Rem, l, r) { }
 
 void RemExpr::print() const {
     llvm::outs() << toString();
@@ -82,7 +83,7 @@ std::string RemExpr::toString() const {
 }
 
 AndExpr::AndExpr(Expr* l, Expr* r) :
-    BinaryExpr(l, r) { }
+    BinaryExpr(EK_And, l, r) { }
 
 void AndExpr::print() const {
     llvm::outs() << toString();
@@ -93,7 +94,7 @@ std::string AndExpr::toString() const {
 }
 
 OrExpr::OrExpr(Expr* l, Expr* r) :
-    BinaryExpr(l, r) { }
+    BinaryExpr(EK_Or, l, r) { }
 
 void OrExpr::print() const {
     llvm::outs() << toString();
@@ -104,7 +105,7 @@ std::string OrExpr::toString() const {
 }
 
 XorExpr::XorExpr(Expr* l, Expr* r) :
-    BinaryExpr(l, r) { }
+    BinaryExpr(EK_Xor, l, r) { }
 
 void XorExpr::print() const {
     llvm::outs() << toString();
@@ -115,7 +116,7 @@ std::string XorExpr::toString() const {
 }
 
 CmpExpr::CmpExpr(Expr* l, Expr* r, const std::string& cmp, bool isUnsigned) :
-    BinaryExpr(l,r) {
+    BinaryExpr(EK_Cmp, l, r) {
     comparsion = cmp;
     this->isUnsigned = isUnsigned;
     setType(std::make_unique<IntType>(false));
@@ -138,7 +139,7 @@ std::string CmpExpr::toString() const {
 }
 
 AshrExpr::AshrExpr(Expr* l, Expr* r) :
-    BinaryExpr(l, r) { }
+    BinaryExpr(EK_Ashr, l, r) { }
 
 void AshrExpr::print() const {
     llvm::outs() << toString();
@@ -149,7 +150,7 @@ std::string AshrExpr::toString() const {
 }
 
 LshrExpr::LshrExpr(Expr* l, Expr* r) :
-    BinaryExpr(l, r) { }
+    BinaryExpr(EK_Lshr, l, r) { }
 
 void LshrExpr::print() const {
     llvm::outs() << toString();
@@ -167,7 +168,7 @@ std::string LshrExpr::toString() const {
 }
 
 ShlExpr::ShlExpr(Expr* l, Expr* r) :
-    BinaryExpr(l, r) { }
+    BinaryExpr(EK_Shl, l, r) { }
 
 void ShlExpr::print() const {
     llvm::outs() << toString();
@@ -12,7 +12,11 @@ public:
     Expr* left; //first operand of binary operation
     Expr* right; //second operand of binary operation
 
-    BinaryExpr(Expr*, Expr*);
+    BinaryExpr(ExprKind, Expr*, Expr*);
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() >= EK_FirstBinary && expr->getKind() <= EK_LastBinary;
+    }
 };
 
 /**
@@ -24,6 +28,10 @@ public:
 
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_Add;
+    }
 };
 
 /**
@@ -35,6 +43,10 @@ public:
 
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_Sub;
+    }
 };
 
 /**
@@ -46,6 +58,10 @@ public:
 
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_Assign;
+    }
 };
 
 /**
@@ -57,6 +73,10 @@ public:
 
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_Mul;
+    }
 };
 
 /**
@@ -68,6 +88,10 @@ public:
 
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_Div;
+    }
 };
 
 /**
@@ -79,6 +103,10 @@ public:
 
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_Rem;
+    }
 };
 
 /**
@@ -90,6 +118,10 @@ public:
 
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_And;
+    }
 };
 
 /**
@@ -101,6 +133,10 @@ public:
 
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_Or;
+    }
 };
 
 /**
@@ -111,6 +147,10 @@ public:
     XorExpr(Expr*, Expr*);
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_Xor;
+    }
 };
 
 /**
@@ -125,6 +165,10 @@ public:
     CmpExpr(Expr*, Expr*, const std::string&, bool);
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_Cmp;
+    }
 };
 
 /**
@@ -136,6 +180,10 @@ public:
 
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_Ashr;
+    }
 };
 
 /**
@@ -147,6 +195,10 @@ public:
 
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_Lshr;
+    }
 };
 
 /**
@@ -158,4 +210,8 @@ public:
 
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_Shl;
+    }
 };
@@ -3,8 +3,30 @@
 
 #include "llvm/Support/raw_ostream.h"
 
+#include "../core/MemoryReport.h"
+
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+void* Expr::operator new(std::size_t size) {
+    void* ptr = std::malloc(size);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+
+    MemoryReport::allocated(MemoryReport::EXPR, size);
+    return ptr;
+}
+
+void Expr::operator delete(void* ptr, std::size_t size) {
+    MemoryReport::deallocated(MemoryReport::EXPR, size);
+    std::free(ptr);
+}
+
 Struct::Struct(const std::string& name)
-    : name(name),
+    : ExprBase(EK_Struct),
+      name(name),
       isPrinted(false) {
     setType(std::make_unique<StructType>(this->name));
 }
@@ -19,12 +41,17 @@ std::string Struct::toString() const {
     ret += "struct ";
     ret += name + " {\n";
 
-    for (const auto& item : items) {
+    for (unsigned i = 0; i < items.size(); i++) {
+        const auto& item = items[i];
         std::string faPointer;
 
+        if (!padding.empty() && padding[i] > 0) {
+            ret += "    char padding" + std::to_string(i) + "[" + std::to_string(padding[i]) + "];\n";
+        }
+
         ret += "    " + item.first->toString();
 
-        if (auto PT = dynamic_cast<PointerType*>(item.first.get())) {
+        if (auto PT = llvm::dyn_cast<PointerType>(item.first.get())) {
             if (PT->isArrayPointer) {
                 faPointer = " (";
                 for (unsigned i = 0; i < PT->levels; i++) {
@@ -37,7 +64,7 @@ std::string Struct::toString() const {
         if (faPointer.empty()) {
             ret += " ";
 
-            if (auto AT = dynamic_cast<ArrayType*>(item.first.get())) {
+            if (auto AT = llvm::dyn_cast<ArrayType>(item.first.get())) {
                 if (AT->isPointerArray && AT->pointer->isArrayPointer) {
                     ret += "(";
                     for (unsigned i = 0; i < AT->pointer->levels; i++) {
@@ -57,7 +84,29 @@ std::string Struct::toString() const {
         ret += ";\n";
     }
 
-    ret += "};";
+    ret += "}";
+
+    if (isPacked) {
+        ret += " __attribute__((packed";
+        if (alignment > 0) {
+            ret += ", aligned(" + std::to_string(alignment) + ")";
+        }
+        ret += "))";
+    }
+
+    return ret + ";";
+}
+
+std::string Struct::layoutAssertsToString() const {
+    if (!hasLayout) {
+        return "";
+    }
+
+    std::string ret = "_Static_assert(sizeof(struct " + name + ") == " + std::to_string(size) + ", \"size of struct " + name + "\");\n";
+    for (unsigned i = 0; i < items.size(); i++) {
+        ret += "_Static_assert(__builtin_offsetof(struct " + name + ", " + items[i].second + ") == " + std::to_string(offsets[i])
+                + ", \"offset of " + name + "." + items[i].second + "\");\n";
+    }
 
     return ret;
 }
@@ -67,7 +116,8 @@ void Struct::addItem(std::unique_ptr<Type> type, const std::string& name) {
 }
 
 StructElement::StructElement(Struct* strct, Expr* expr, unsigned element)
-    : strct(strct),
+    : ExprBase(EK_StructElement),
+      strct(strct),
       expr(expr),
       element(element) {
     setType(strct->items[element].first->clone());
@@ -78,7 +128,7 @@ void StructElement::print() const {
 }
 
 std::string StructElement::toString() const {
-    if (dynamic_cast<PointerType*>(expr->getType())) {
+    if (llvm::dyn_cast_or_null<PointerType>(expr->getType())) {
         return "(" + expr->toString() + ")->" + strct->items[element].second;
     }
 
@@ -86,14 +136,16 @@ std::string StructElement::toString() const {
 }
 
 ArrayElement::ArrayElement(Expr* expr, Expr* elem)
-    : expr(expr),
+    : ExprBase(EK_ArrayElement),
+      expr(expr),
       element(elem) {
     ArrayType* AT = static_cast<ArrayType*>(expr->getType());
     setType(AT->type->clone());
 }
 
 ArrayElement::ArrayElement(Expr* expr, Expr* elem, std::unique_ptr<Type> type)
-    : expr(expr),
+    : ExprBase(EK_ArrayElement),
+      expr(expr),
       element(elem) {
     setType(std::move(type));
 }
@@ -106,7 +158,8 @@ std::string ArrayElement::toString() const {
     return "(" + expr->toString() + ")[" + element->toString() + "]";
 }
 
-ExtractValueExpr::ExtractValueExpr(std::vector<std::unique_ptr<Expr>>& indices) {
+ExtractValueExpr::ExtractValueExpr(std::vector<std::unique_ptr<Expr>>& indices)
+    : ExprBase(EK_ExtractValue) {
     for (auto& idx : indices) {
         this->indices.push_back(std::move(idx));
     }
@@ -122,7 +175,11 @@ std::string ExtractValueExpr::toString() const {
     return indices[indices.size() - 1]->toString();
 }
 
-Value::Value(const std::string& valueName, std::unique_ptr<Type> type) {
+Value::Value(const std::string& valueName, std::unique_ptr<Type> type)
+    : Value(EK_Value, valueName, std::move(type)) { }
+
+Value::Value(ExprKind kind, const std::string& valueName, std::unique_ptr<Type> type)
+    : ExprBase(kind) {
     setType(std::move(type));
     this->valueName = valueName;
     init = false;
@@ -139,7 +196,7 @@ std::string Value::toString() const {
 
     if (!init) {
         std::string ret;
-        if (auto PT = dynamic_cast<const PointerType*>(getType())) {
+        if (auto PT = llvm::dyn_cast_or_null<PointerType>(getType())) {
             if (PT->isArrayPointer && valueName.compare("0") != 0) {
                 ret = "(";
                 for (unsigned i = 0; i < PT->levels; i++) {
@@ -157,7 +214,7 @@ std::string Value::toString() const {
             }
         }
 
-        if (auto AT = dynamic_cast<const ArrayType*>(getType())) {
+        if (auto AT = llvm::dyn_cast_or_null<ArrayType>(getType())) {
             if (AT->isPointerArray && AT->pointer->isArrayPointer) {
                 ret = "(";
                 for (unsigned i = 0; i < AT->pointer->levels; i++) {
@@ -173,51 +230,25 @@ std::string Value::toString() const {
     return valueName;
 }
 
+std::string Value::alignToString() const {
+    if (align == 0) {
+        return "";
+    }
+
+    return " __attribute__((aligned(" + std::to_string(align) + ")))";
+}
+
 GlobalValue::GlobalValue(const std::string& varName, const std::string& value, std::unique_ptr<Type> type)
-    : Value(varName, std::move(type)),
+    : Value(EK_GlobalValue, varName, std::move(type)),
       value(value) { }
 
 void GlobalValue::print() const {
     llvm::outs() << toString();
 }
 
-std::string GlobalValue::toString() const {   
+std::string GlobalValue::toString() const {
     if (!init) {
-        std::string ret = getType()->toString() + " ";
-        if (auto AT = dynamic_cast<const ArrayType*>(getType())) {
-            if (AT->isPointerArray && AT->pointer->isArrayPointer) {
-                ret += "(";
-                for (unsigned i = 0; i < AT->pointer->levels; i++) {
-                    ret += "*";
-                }
-                ret += valueName + AT->sizeToString() + ")" + AT->pointer->sizes;
-            } else {
-                ret += " " + valueName + AT->sizeToString();;
-            }
-        } else if (auto PT = dynamic_cast<const PointerType*>(getType())) {
-            if (PT->isArrayPointer && valueName.compare("0") != 0) {
-                ret += "(";
-                for (unsigned i = 0; i < PT->levels; i++) {
-                    ret += "*";
-                }
-                ret += valueName + ")";
-            } else {
-                ret += " " + valueName;
-
-                if (!value.empty()) {
-                    ret += " = " + value;
-                }
-
-                return ret + ";";
-            }
-
-            if (PT->isArrayPointer) {
-                ret = ret + PT->sizes;
-            }
-        } else {
-            ret += valueName;
-        }
-
+        std::string ret = definitionToString();
         if (!value.empty()) {
             ret += " = " + value;
         }
@@ -229,8 +260,12 @@ std::string GlobalValue::toString() const {
 }
 
 std::string GlobalValue::declToString() const {
+    return definitionToString() + ";";
+}
+
+std::string GlobalValue::definitionToString() const {
     std::string ret = getType()->toString();
-    if (auto AT = dynamic_cast<const ArrayType*>(getType())) {
+    if (auto AT = llvm::dyn_cast_or_null<ArrayType>(getType())) {
         if (AT->isPointerArray && AT->pointer->isArrayPointer) {
             ret += " (";
             for (unsigned i = 0; i < AT->pointer->levels; i++) {
@@ -240,7 +275,7 @@ std::string GlobalValue::declToString() const {
         } else {
             ret += " " + valueName + AT->sizeToString();;
         }
-    } else if (auto PT = dynamic_cast<const PointerType*>(getType())) {
+    } else if (auto PT = llvm::dyn_cast_or_null<PointerType>(getType())) {
         if (PT->isArrayPointer && valueName.compare("0") != 0) {
             ret += "(";
             for (unsigned i = 0; i < PT->levels; i++) {
@@ -248,7 +283,7 @@ std::string GlobalValue::declToString() const {
             }
             ret += valueName + ")";
         } else {
-            return ret + " " + valueName + ";";
+            return ret + " " + valueName + attributesToString();
         }
 
         if (PT->isArrayPointer) {
@@ -260,16 +295,26 @@ std::string GlobalValue::declToString() const {
         ret += " " + valueName;
     }
 
-    return ret + ";";
+    return ret + attributesToString();
+}
+
+std::string GlobalValue::attributesToString() const {
+    if (isHidden) {
+        return alignToString() + " __attribute__((visibility(\"hidden\")))";
+    }
+
+    return alignToString();
 }
 
 IfExpr::IfExpr(Expr* cmp, const std::string& trueBlock, const std::string& falseBlock)
-    : cmp(cmp),
+    : ExprBase(EK_If),
+      cmp(cmp),
       trueBlock(trueBlock),
       falseBlock(falseBlock) {}
 
 IfExpr::IfExpr(const std::string &trueBlock)
-    : cmp(nullptr),
+    : ExprBase(EK_If),
+      cmp(nullptr),
       trueBlock(trueBlock),
       falseBlock("") {}
 
@@ -285,24 +330,47 @@ std::string IfExpr::toString() const {
     return "goto " + trueBlock + ";";
 }
 
-SwitchExpr::SwitchExpr(Expr* cmp, const std::string &def, std::map<int, std::string> cases)
-    : cmp(cmp),
+SwitchExpr::SwitchExpr(Expr* cmp, const std::string &def, std::vector<std::string> successors, std::vector<CaseRange> cases)
+    : ExprBase(EK_Switch),
+      cmp(cmp),
       def(def),
-      cases(cases) {}
+      successors(std::move(successors)),
+      cases(std::move(cases)) {}
 
 void SwitchExpr::print() const {
     llvm::outs() << toString();
 }
 
+std::string SwitchExpr::caseValueToString(int64_t value) {
+    //the minimal value cannot be written as a negated literal, as the literal would not fit into long long
+    if (value == INT64_MIN) {
+        return "(-9223372036854775807LL - 1)";
+    }
+
+    return std::to_string(value);
+}
+
 std::string SwitchExpr::toString() const {
     std::string ret;
 
     ret += "switch(" + cmp->toString();
     ret += ") {\n";
 
-    for (const auto &iter : cases) {
-        ret += "    case " + std::to_string(iter.first);
-        ret += ":\n        goto " + iter.second;
+    //cases with the same successor share one goto
+    std::vector<std::vector<const CaseRange*>> successorCases(successors.size());
+    for (const auto& range : cases) {
+        successorCases[range.successor].push_back(&range);
+    }
+
+    for (unsigned i = 0; i < successors.size(); i++) {
+        for (const CaseRange* range : successorCases[i]) {
+            ret += "    case " + caseValueToString(range->low);
+            if (range->high != range->low) {
+                ret += " ... " + caseValueToString(range->high);
+            }
+            ret += ":\n";
+        }
+        ret += "        goto " + successors[i];
         ret += ";\n";
     }
 
@@ -315,18 +383,21 @@ std::string SwitchExpr::toString() const {
     return ret + "    }";
 }
 
-AsmExpr::AsmExpr(const std::string& inst, const std::vector<std::pair<std::string, Expr*>>& output, const std::vector<std::pair<std::string, Expr*>>& input, const std::string& clobbers)
-    : inst(inst),
+AsmExpr::AsmExpr(const std::string& inst, const std::vector<std::pair<std::string, Expr*>>& output, const std::vector<std::pair<std::string, Expr*>>& input, const std::string& clobbers, bool isVolatile)
+    : ExprBase(EK_Asm),
+      inst(inst),
       output(output),
       input(input),
-      clobbers(clobbers) {}
+      clobbers(clobbers),
+      isVolatile(isVolatile) {}
 
 void AsmExpr::print() const {
     llvm::outs() << toString();
 }
 
 std::string AsmExpr::toString() const {
-    std::string ret = "__asm__(\"" + inst + "\"\n        : ";
+    std::string ret = isVolatile ? "__asm__ __volatile__(\"" : "__asm__(\"";
+    ret += inst + "\"\n        : ";
     if (!output.empty()) {
         bool first = true;
         for (const auto& out : output) {
@@ -375,7 +446,8 @@ void AsmExpr::addOutputExpr(Expr* expr, unsigned pos) {
 }
 
 CallExpr::CallExpr(Expr* funcValue, const std::string &funcName, std::vector<Expr*> params, std::unique_ptr<Type> type)
-    : funcName(funcName),
+    : ExprBase(EK_Call),
+      funcName(funcName),
       params(params),
       funcValue(funcValue) {
     setType(std::move(type));
@@ -396,7 +468,7 @@ std::string CallExpr::toString() const {
 
     ret += paramsToString();
 
-    if (const auto VT = dynamic_cast<const VoidType*>(getType())) {
+    if (llvm::isa<VoidType>(getType())) {
         return ret + ");";
     }
     return ret + ")";
@@ -431,10 +503,11 @@ std::string CallExpr::paramsToString() const {
 }
 
 PointerShift::PointerShift(std::unique_ptr<Type> ptrType, Expr* pointer, Expr* move)
-    : ptrType(std::move(ptrType)),
+    : ExprBase(EK_PointerShift),
+      ptrType(std::move(ptrType)),
       pointer(pointer),
       move(move) {
-    if (auto PT = dynamic_cast<PointerType*>(this->ptrType.get())) {
+    if (auto PT = llvm::dyn_cast<PointerType>(this->ptrType.get())) {
         setType(PT->type->clone());
     }
 }
@@ -465,7 +538,8 @@ std::string PointerShift::toString() const {
     return ret + ")(" + pointer->toString() + ")) + (" + move->toString() + "))";
 }
 
-GepExpr::GepExpr(std::vector<std::unique_ptr<Expr>>& indices) {
+GepExpr::GepExpr(std::vector<std::unique_ptr<Expr>>& indices)
+    : ExprBase(EK_Gep) {
     for (auto& index : indices) {
         this->indices.push_back(std::move(index));
     }
@@ -482,6 +556,7 @@ std::string GepExpr::toString() const {
 }
 
 SelectExpr::SelectExpr(Expr* comp, Expr* l, Expr* r) :
+    ExprBase(EK_Select),
     left(l),
     right(r),
     comp(comp) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <map>
 #include <vector>
@@ -14,12 +15,79 @@
  */
 class Expr {
 public:
+    /**
+     * @brief The ExprKind enum identifies the class of the expression, it is used by llvm::isa, llvm::dyn_cast and ExprVisitor.
+     * Kinds of subclasses of Value, BinaryExpr and UnaryExpr have to be kept in contiguous ranges.
+     */
+    enum ExprKind {
+        EK_Struct,
+        EK_StructElement,
+        EK_ArrayElement,
+        EK_ExtractValue,
+        EK_Value,
+        EK_GlobalValue,
+        EK_LastValue = EK_GlobalValue,
+        EK_If,
+        EK_Switch,
+        EK_Asm,
+        EK_Call,
+        EK_PointerShift,
+        EK_Gep,
+        EK_Select,
+        EK_Add,
+        EK_Sub,
+        EK_Assign,
+        EK_Mul,
+        EK_Div,
+        EK_Rem,
+        EK_And,
+        EK_Or,
+        EK_Xor,
+        EK_Cmp,
+        EK_Ashr,
+        EK_Lshr,
+        EK_Shl,
+        EK_FirstBinary = EK_Add,
+        EK_LastBinary = EK_Shl,
+        EK_Ref,
+        EK_Deref,
+        EK_Ret,
+        EK_Cast,
+        EK_FirstUnary = EK_Ref,
+        EK_LastUnary = EK_Cast
+    };
+
+private:
+    const ExprKind kind;
+
+public:
+    Expr(ExprKind kind)
+        : kind(kind) { }
+
     virtual ~Expr() = default;
     virtual void print() const = 0;
     virtual std::string toString() const = 0;
     virtual const Type* getType() const = 0;
     virtual Type* getType() = 0;
     virtual void setType(std::unique_ptr<Type>) = 0;
+
+    ExprKind getKind() const {
+        return kind;
+    }
+
+    /**
+     * @brief operator new Allocates the expression, the allocation is counted in the memory report.
+     * @param size Size of the expression
+     * @return Pointer to the allocated memory
+     */
+    static void* operator new(std::size_t size);
+
+    /**
+     * @brief operator delete Deallocates the expression, the deallocation is counted in the memory report.
+     * @param ptr Pointer to the expression
+     * @param size Size of the expression
+     */
+    static void operator delete(void* ptr, std::size_t size);
 };
 
 /**
@@ -30,6 +98,9 @@ private:
     std::unique_ptr<Type> type;
 
 public:
+    ExprBase(ExprKind kind)
+        : Expr(kind) { }
+
     const Type* getType() const override {
         return type.get();
     }
@@ -53,17 +124,36 @@ public:
 
     bool isPrinted; //used for printing structs in the right order
 
+    //layout of the struct, which is kept by packing when the natural layout of C differs from the module
+    bool isPacked = false; //struct is output with __attribute__((packed))
+    uint64_t alignment = 0; //alignment of a packed struct restored by __attribute__((aligned)), 0 if none
+    std::vector<uint64_t> padding; //bytes of padding inserted before every element of a packed struct, empty if none
+    bool hasLayout = false; //size and offsets are known from the DataLayout
+    uint64_t size = 0; //size of the struct in bytes
+    std::vector<uint64_t> offsets; //offsets of the elements in bytes
+
     Struct(const std::string&);
 
     void print() const override;
     std::string toString() const override;
 
+    /**
+     * @brief layoutAssertsToString Returns static assertions checking that the size of the struct
+     * and offsets of its elements are the same as in the module.
+     * @return String containing _Static_asserts, empty if the layout is not known
+     */
+    std::string layoutAssertsToString() const;
+
     /**
      * @brief addItem Adds new struct element to the vector items.
      * @param type Type of the element
      * @param name Name of the element
      */
     void addItem(std::unique_ptr<Type> type, const std::string& name);
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_Struct;
+    }
 };
 
 /**
@@ -80,6 +170,10 @@ public:
 
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_StructElement;
+    }
 };
 
 /**
@@ -96,6 +190,10 @@ public:
 
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_ArrayElement;
+    }
 };
 
 /**
@@ -110,20 +208,38 @@ public:
 
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_ExtractValue;
+    }
 };
 
 /**
  * @brief The Value class represents variable or constant value.
  */
 class Value : public ExprBase {
+protected:
+    Value(ExprKind, const std::string&, std::unique_ptr<Type>);
+
 public:
     std::string valueName;
     bool init; //used for declaration printing
+    unsigned align = 0; //alignment of the variable, 0 if the variable has natural alignment of its type
 
     Value(const std::string&, std::unique_ptr<Type>);
 
     void print() const override;
     std::string toString() const override;
+
+    /**
+     * @brief alignToString Returns aligned attribute for declaration of over-aligned variable.
+     * @return String containing the attribute or empty string if the variable has natural alignment
+     */
+    std::string alignToString() const;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() >= EK_Value && expr->getKind() <= EK_LastValue;
+    }
 };
 
 /**
@@ -133,6 +249,12 @@ class GlobalValue : public Value {
 private:
     std::string value;
 
+    /**
+     * @brief attributesToString Returns attributes of the global variable (alignment and visibility).
+     * @return String containing the attributes or empty string if the variable has no attributes
+     */
+    std::string attributesToString() const;
+
 public:
     GlobalValue(const std::string&, const std::string&, std::unique_ptr<Type>);
 
@@ -140,12 +262,23 @@ public:
     std::string toString() const override;
 
     bool isDefined = false;
+    bool isHidden = false; //variable has hidden visibility, used for internal variables when the program is split into multiple files
 
     /**
      * @brief declToString Returns string containing declaration only.
      * @return String containing declaration of the global variable;
      */
     std::string declToString() const;
+
+    /**
+     * @brief definitionToString Returns string containing the declarator of the global variable without initializer and semicolon.
+     * @return String containing definition of the global variable without initializer
+     */
+    std::string definitionToString() const;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_GlobalValue;
+    }
 };
 
 /**
@@ -163,22 +296,53 @@ public:
 
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_If;
+    }
 };
 
 /**
  * @brief The SwitchExpr class represents switch.
  */
 class SwitchExpr : public ExprBase {
+public:
+    /**
+     * @brief The CaseRange struct represents consecutive case values with the same successor.
+     */
+    struct CaseRange {
+        int64_t low;
+        int64_t high;
+        unsigned successor; //index of the successor in successors
+    };
+
 private:
     Expr* cmp; //expression used in switch
     std::string def; //default
-    std::map<int, std::string> cases; //cases of switch
+    std::vector<std::string> successors; //names of blocks that are targets of cases, every block is present only once
+    std::vector<CaseRange> cases; //cases of switch sorted by value
+
+    /**
+     * @brief caseValueToString Returns C literal of the case value.
+     * @param value Value of the case
+     * @return String containing the literal
+     */
+    static std::string caseValueToString(int64_t value);
 
 public:
-    SwitchExpr(Expr*, const std::string&, std::map<int, std::string>);
+    SwitchExpr(Expr*, const std::string&, std::vector<std::string>, std::vector<CaseRange>);
 
     void print() const override;
+
+    /**
+     * @brief toString Returns the switch with cases grouped by their successors, consecutive cases are output as GNU case ranges.
+     * @return String containing the switch
+     */
     std::string toString() const override;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_Switch;
+    }
 };
 
 /**
@@ -190,9 +354,10 @@ private:
     std::vector<std::pair<std::string, Expr*>> output; //output constraints
     std::vector<std::pair<std::string, Expr*>> input; //input constraints
     std::string clobbers; //clobber
+    bool isVolatile; //asm has side effects and must not be removed or moved by the C compiler
 
 public:
-    AsmExpr(const std::string&, const std::vector<std::pair<std::string, Expr*>>&, const std::vector<std::pair<std::string, Expr*>>&, const std::string&);
+    AsmExpr(const std::string&, const std::vector<std::pair<std::string, Expr*>>&, const std::vector<std::pair<std::string, Expr*>>&, const std::string&, bool);
 
     void print() const override;
     std::string toString() const override;
@@ -203,6 +368,10 @@ public:
      * @param pos Position in vector
      */
     void addOutputExpr(Expr* expr, unsigned pos);
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_Asm;
+    }
 };
 
 /**
@@ -231,6 +400,10 @@ public:
      * @return String with parameters.
      */
     std::string paramsToString() const;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_Call;
+    }
 };
 
 /**
@@ -247,6 +420,10 @@ public:
 
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_PointerShift;
+    }
 };
 
 /**
@@ -261,6 +438,10 @@ public:
 
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_Gep;
+    }
 };
 
 /**
@@ -277,4 +458,8 @@ public:
 
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_Select;
+    }
 };
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "Expr.h"
+#include "BinaryExpr.h"
+#include "UnaryExpr.h"
+
+#include "llvm/Support/ErrorHandling.h"
+
+/**
+ * @brief The ExprVisitor class dispatches expressions to the visit method of their class using the expression kind.
+ * Subclasses (CRTP) override only the methods they are interested in. Methods that are not overridden delegate
+ * to the method of the base class of the expression (e.g. visitAddExpr -> visitBinaryExpr -> visitExpr).
+ */
+template<typename SubClass, typename RetTy = void>
+class ExprVisitor {
+public:
+#define DISPATCH(KIND, CLASS) \
+    case Expr::KIND: \
+        return static_cast<SubClass*>(this)->visit##CLASS(static_cast<CLASS*>(expr))
+
+    /**
+     * @brief visit Calls visit method corresponding to the class of the expression.
+     * @param expr Expression being visited
+     * @return Value returned by the visit method
+     */
+    RetTy visit(Expr* expr) {
+        switch (expr->getKind()) {
+        DISPATCH(EK_Struct, Struct);
+        DISPATCH(EK_StructElement, StructElement);
+        DISPATCH(EK_ArrayElement, ArrayElement);
+        DISPATCH(EK_ExtractValue, ExtractValueExpr);
+        DISPATCH(EK_Value, Value);
+        DISPATCH(EK_GlobalValue, GlobalValue);
+        DISPATCH(EK_If, IfExpr);
+        DISPATCH(EK_Switch, SwitchExpr);
+        DISPATCH(EK_Asm, AsmExpr);
+        DISPATCH(EK_Call, CallExpr);
+        DISPATCH(EK_PointerShift, PointerShift);
+        DISPATCH(EK_Gep, GepExpr);
+        DISPATCH(EK_Select, SelectExpr);
+        DISPATCH(EK_Add, AddExpr);
+        DISPATCH(EK_Sub, SubExpr);
+        DISPATCH(EK_Assign, AssignExpr);
+        DISPATCH(EK_Mul, MulExpr);
+        DISPATCH(EK_Div, DivExpr);
+        DISPATCH(EK_Rem, RemExpr);
+        DISPATCH(EK_And, AndExpr);
+        DISPATCH(EK_Or, OrExpr);
+        DISPATCH(EK_Xor, XorExpr);
+        DISPATCH(EK_Cmp, CmpExpr);
+        DISPATCH(EK_Ashr, AshrExpr);
+        DISPATCH(EK_Lshr, LshrExpr);
+        DISPATCH(EK_Shl, ShlExpr);
+        DISPATCH(EK_Ref, RefExpr);
+        DISPATCH(EK_Deref, DerefExpr);
+        DISPATCH(EK_Ret, RetExpr);
+        DISPATCH(EK_Cast, CastExpr);
+        }
+
+        llvm_unreachable("Unknown expression kind!");
+    }
+
+#undef DISPATCH
+
+#define DELEGATE(CLASS, PARENT) \
+    RetTy visit##CLASS(CLASS* expr) { \
+        return static_cast<SubClass*>(this)->visit##PARENT(expr); \
+    }
+
+    /**
+     * @brief visitExpr Default visit method, called for every expression whose visit method is not overridden.
+     * @param expr Expression being visited
+     * @return Default value of RetTy
+     */
+    RetTy visitExpr(Expr* expr) {
+        return RetTy();
+    }
+
+    DELEGATE(Struct, Expr)
+    DELEGATE(StructElement, Expr)
+    DELEGATE(ArrayElement, Expr)
+    DELEGATE(ExtractValueExpr, Expr)
+    DELEGATE(Value, Expr)
+    DELEGATE(GlobalValue, Value)
+    DELEGATE(IfExpr, Expr)
+    DELEGATE(SwitchExpr, Expr)
+    DELEGATE(AsmExpr, Expr)
+    DELEGATE(CallExpr, Expr)
+    DELEGATE(PointerShift, Expr)
+    DELEGATE(GepExpr, Expr)
+    DELEGATE(SelectExpr, Expr)
+
+    DELEGATE(BinaryExpr, Expr)
+    DELEGATE(AddExpr, BinaryExpr)
+    DELEGATE(SubExpr, BinaryExpr)
+    DELEGATE(AssignExpr, BinaryExpr)
+    DELEGATE(MulExpr, BinaryExpr)
+    DELEGATE(DivExpr, BinaryExpr)
+    DELEGATE(RemExpr, BinaryExpr)
+    DELEGATE(AndExpr, BinaryExpr)
+    DELEGATE(OrExpr, BinaryExpr)
+    DELEGATE(XorExpr, BinaryExpr)
+    DELEGATE(CmpExpr, BinaryExpr)
+    DELEGATE(AshrExpr, BinaryExpr)
+    DELEGATE(LshrExpr, BinaryExpr)
+    DELEGATE(ShlExpr, BinaryExpr)
+
+    DELEGATE(UnaryExpr, Expr)
+    DELEGATE(RefExpr, UnaryExpr)
+    DELEGATE(DerefExpr, UnaryExpr)
+    DELEGATE(RetExpr, UnaryExpr)
+    DELEGATE(CastExpr, UnaryExpr)
+
+#undef DELEGATE
+};
@@ -6,7 +6,8 @@
  * UnaryExpr classes
  */
 
-UnaryExpr::UnaryExpr(Expr *expr) {
+UnaryExpr::UnaryExpr(ExprKind kind, Expr *expr)
+    : ExprBase(kind) {
     this->expr = expr;
     if (expr) {
         setType(expr->getType()->clone());
@@ -14,7 +15,7 @@ UnaryExpr::UnaryExpr(Expr *expr) {
 }
 
 RefExpr::RefExpr(Expr* expr) :
-    UnaryExpr(expr) {
+    UnaryExpr(EK_Ref, expr) {
     setType(std::make_unique<PointerType>(expr->getType()->clone()));
 }
 
@@ -27,8 +28,8 @@ std::string RefExpr::toString() const {
 }
 
 DerefExpr::DerefExpr(Expr* expr) :
-    UnaryExpr(expr) {
-    if (auto PT = dynamic_cast<PointerType*>(expr->getType())) {
+    UnaryExpr(EK_Deref, expr) {
+    if (auto PT = llvm::dyn_cast_or_null<PointerType>(expr->getType())) {
         setType(PT->type->clone());
     }
 }
@@ -38,7 +39,7 @@ void DerefExpr::print() const {
 }
 
 std::string DerefExpr::toString() const {
-    if (auto refExpr = dynamic_cast<RefExpr*>(expr)) {
+    if (auto refExpr = llvm::dyn_cast_or_null<RefExpr>(expr)) {
         return refExpr->expr->toString();
     }
 
@@ -46,18 +47,30 @@ std::string DerefExpr::toString() const {
 }
 
 RetExpr::RetExpr(Expr* ret)
-    : UnaryExpr(ret) { }
+    : UnaryExpr(EK_Ret, ret) { }
 
 RetExpr::RetExpr()
-    : UnaryExpr(nullptr) { }
+    : UnaryExpr(EK_Ret, nullptr) { }
 
 void RetExpr::print() const {
     llvm::outs() << toString();
 }
 
 std::string RetExpr::toString() const {
+    //only musttail calls of void functions are returned, ISO C does not allow it in the return statement,
+    //so the call is returned only by the musttail helper when the attribute is available
+    if (expr && llvm::dyn_cast_or_null<VoidType>(expr->getType())) {
+        std::string call = expr->toString();
+        call.pop_back();
+        return "LLVM2C_MUSTTAIL_VOID(" + call + ");";
+    }
+
     std::string ret;
 
+    if (mustTail) {
+        ret += "LLVM2C_MUSTTAIL ";
+    }
+
     ret += "return";
     if (expr) {
         ret += " " + expr->toString();
@@ -67,7 +80,7 @@ std::string RetExpr::toString() const {
 }
 
 CastExpr::CastExpr(Expr* expr, std::unique_ptr<Type> type)
-    : UnaryExpr(expr) {
+    : UnaryExpr(EK_Cast, expr) {
     setType(std::move(type));
 }
 
@@ -77,7 +90,7 @@ void CastExpr::print() const {
 
 std::string CastExpr::toString() const {
     std::string ret = "(" + getType()->toString();
-    if (auto PT = dynamic_cast<const PointerType*>(getType())) {
+    if (auto PT = llvm::dyn_cast_or_null<PointerType>(getType())) {
         if (PT->isArrayPointer) {
             ret += " (";
             for (unsigned i = 0; i < PT->levels; i++) {
@@ -9,9 +9,13 @@
  */
 class UnaryExpr : public ExprBase {
 public:
-    UnaryExpr(Expr *);
+    UnaryExpr(ExprKind, Expr *);
 
     Expr* expr; //operand of unary operation
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() >= EK_FirstUnary && expr->getKind() <= EK_LastUnary;
+    }
 };
 
 /**
@@ -23,6 +27,10 @@ public:
 
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_Ref;
+    }
 };
 
 /**
@@ -34,6 +42,10 @@ public:
 
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_Deref;
+    }
 };
 
 /**
@@ -41,11 +53,17 @@ public:
  */
 class RetExpr : public UnaryExpr {
 public:
+    bool mustTail = false; //returned expression is a call that must be tail call
+
     RetExpr(Expr*);
     RetExpr();
 
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_Ret;
+    }
 };
 
 /**
@@ -57,4 +75,8 @@ public:
 
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Expr* expr) {
+        return expr->getKind() == EK_Cast;
+    }
 };
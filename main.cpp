@@ -1,17 +1,49 @@
 #include "core/Program.h"
+#include "core/MemoryReport.h"
+#include "core/Trace.h"
 
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/CommandLine.h"
 
+#include <cstdlib>
 #include <iostream>
+#include <new>
 #include <string>
 
 using namespace llvm;
 
+//every allocation of llvm2c is counted by the memory report, allocations of Expr and Type are counted by their own operator new
+void* operator new(std::size_t size) {
+    void* ptr = std::malloc(size ? size : 1);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+
+    MemoryReport::allocated(MemoryReport::OTHER, size);
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
 int main(int argc, char** argv) {
     cl::OptionCategory options("llvm2c options");
     cl::opt<std::string> Output("o", cl::desc("Output filename"), cl::value_desc("filename"), cl::cat(options));
-    cl::opt<std::string> Input(cl::Positional, cl::Required, cl::desc("<input>"), cl::cat(options));
+    cl::list<std::string> Inputs(cl::Positional, cl::OneOrMore, cl::desc("<input> (LLVM IR, bitcode or archives of bitcode files, multiple inputs are linked)"), cl::cat(options));
+    cl::opt<std::string> Incremental("incremental", cl::desc("Output directory for incremental translation, only changed functions are rewritten"), cl::value_desc("directory"), cl::cat(options));
+    cl::opt<bool> Stream("stream", cl::desc("Translates and outputs functions one at a time, so only one translated function is kept in memory"), cl::cat(options));
+    cl::opt<std::string> MemReport("mem-report", cl::desc("Prints memory usage of translation phases and subsystems to the standard error output"), cl::value_desc("text|json"), cl::ValueOptional, cl::cat(options));
+    cl::opt<std::string> TraceFile("trace", cl::desc("Saves Chrome trace events of the translation to the file"), cl::value_desc("filename"), cl::cat(options));
+    cl::opt<unsigned> TraceBlockThreshold("trace-block-threshold", cl::desc("Minimal number of instructions of a block whose parsing is traced (default 1000)"), cl::init(1000), cl::cat(options));
+    cl::opt<unsigned> CostReport("cost-report", cl::desc("Prints N functions with the highest costs of translation in every category to the standard error output"), cl::value_desc("N"), cl::cat(options));
+    cl::opt<bool> LayoutAsserts("layout-asserts", cl::desc("Checks sizes of structs and offsets of their elements by static assertions"), cl::cat(options));
+    cl::opt<bool> DeadElimination("dead-elimination", cl::desc("Removes functions, global variables and declarations unreachable from externally visible definitions"), cl::cat(options));
+    cl::list<std::string> Roots("roots", cl::desc("Symbols used instead of externally visible definitions as roots of dead elimination, implies --dead-elimination"), cl::value_desc("symbols"), cl::CommaSeparated, cl::cat(options));
     cl::opt<bool> Print("p", cl::desc("Print translated program"), cl::cat(options));
     cl::opt<bool> Debug("debug", cl::desc("Print only information about translation"), cl::cat(options));
     cl::opt<bool> Includes("add-includes", cl::desc("Uses includes instead of declarations. For experimental purposes."), cl::cat(options));
@@ -20,13 +52,28 @@ int main(int argc, char** argv) {
     cl::HideUnrelatedOptions(options);
     cl::ParseCommandLineOptions(argc, argv);
 
-    if (Output.empty() && !Print && !Debug) {
+    if (Output.empty() && Incremental.empty() && !Print && !Debug) {
         std::cout << "Output method not specified!\n";
         return 1;
     }
 
+    if (!MemReport.empty() && MemReport != "text" && MemReport != "json") {
+        std::cout << "Unknown format of memory report!\n";
+        return 1;
+    }
+    MemoryReport::enabled = MemReport.getNumOccurrences() > 0;
+    MemoryReport::countTotals = CostReport > 0;
+    Trace::enabled = !TraceFile.empty();
+    Trace::blockThreshold = TraceBlockThreshold;
+    //the trace is saved even if the translation fails
+    Trace::Saver traceSaver(TraceFile);
+
     try {
-        Program program(Input, Includes, Casts);
+        //functions are parsed on demand, so incremental translation parses only changed functions
+        Program program(std::vector<std::string>(Inputs.begin(), Inputs.end()), Includes, Casts, Stream || !Incremental.empty(),
+                        DeadElimination || !Roots.empty(), std::vector<std::string>(Roots.begin(), Roots.end()));
+        program.costReport = CostReport > 0;
+        program.layoutAsserts = LayoutAsserts;
 
         if (Print) {
             program.print();
@@ -35,10 +82,26 @@ int main(int argc, char** argv) {
         if (!Output.empty()) {
             program.saveFile(Output);
         }
+
+        if (!Incremental.empty()) {
+            program.saveIncremental(Incremental);
+        }
+
+        MemoryReport::phase("output");
+
+        traceSaver.save();
+
+        if (program.costReport) {
+            program.printCostReport(std::cerr, CostReport);
+        }
     } catch (std::invalid_argument& e) {
         std::cerr << e.what();
         return 1;
     }
 
+    if (MemoryReport::enabled) {
+        MemoryReport::print(std::cerr, MemReport == "json");
+    }
+
     return 0;
 }
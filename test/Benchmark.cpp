@@ -0,0 +1,286 @@
+#include "Process.h"
+
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Program.h"
+#include "llvm/Support/SourceMgr.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+using namespace llvm;
+
+//exit code that tells CTest that the benchmark was skipped
+const static int SKIP_CODE = 77;
+
+/**
+ * @brief The Measurement struct contains results of translation of one input compiled with one optimization level.
+ */
+struct Measurement {
+    std::string input; //path relative to the corpus directory
+    std::string optLevel;
+    bool compiled = false; //inputs that clang cannot compile (e.g. templates of tests) are skipped
+    bool translated = false;
+    uint64_t instructions = 0; //number of LLVM instructions of the input
+    double seconds = 0; //fastest translation of all repetitions
+    long peakRssKB = 0; //lowest peak RSS of all repetitions
+    uint64_t outputBytes = 0;
+
+    double getThroughput() const {
+        return seconds > 0 ? instructions / seconds : 0;
+    }
+};
+
+/**
+ * @brief The Metric struct describes a metric compared against the baseline.
+ */
+struct Metric {
+    const char* name;
+    double (*get)(const Measurement&);
+    double minimum; //values of the baseline below the minimum are not compared, as they are dominated by noise
+};
+
+const static Metric METRICS[] = {
+    {"seconds", [](const Measurement& m) { return m.seconds; }, 0.01},
+    {"peak_rss_kb", [](const Measurement& m) { return static_cast<double>(m.peakRssKB); }, 0},
+    {"output_bytes", [](const Measurement& m) { return static_cast<double>(m.outputBytes); }, 0},
+};
+
+/**
+ * @brief getCorpus Returns all C files in the directory and its subdirectories, sorted by their path.
+ */
+static std::vector<std::string> getCorpus(const std::string& dir) {
+    std::vector<std::string> files;
+    std::error_code ec;
+    for (sys::fs::recursive_directory_iterator it(dir, ec), end; it != end && !ec; it.increment(ec)) {
+        StringRef path = it->path();
+        if (path.endswith(".c")) {
+            path.consume_front(dir);
+            files.push_back(path.ltrim('/').str());
+        }
+    }
+
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+/**
+ * @brief countInstructions Returns number of instructions of the module in the file, 0 if it cannot be parsed.
+ */
+static uint64_t countInstructions(const std::string& file) {
+    LLVMContext context;
+    SMDiagnostic error;
+    auto module = parseIRFile(file, error, context);
+    if (!module) {
+        return 0;
+    }
+
+    uint64_t count = 0;
+    for (const Function& func : module->functions()) {
+        for (const BasicBlock& block : func) {
+            count += block.size();
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief measure Compiles the input to LLVM IR and measures its translation.
+ */
+static void measure(Measurement& m, const std::string& corpusDir, const std::string& llvm2c, const std::string& clang, unsigned repeat) {
+    SmallString<128> tempDir;
+    if (sys::fs::createUniqueDirectory("llvm2c-bench", tempDir)) {
+        return;
+    }
+    std::string dir = tempDir.str().str();
+    std::string ir = dir + "/input.ll";
+    std::string output = dir + "/output.c";
+
+    if (runProcess({clang, "-" + m.optLevel, "-emit-llvm", "-S", corpusDir + "/" + m.input, "-o", ir}).status == 0) {
+        m.compiled = true;
+        m.instructions = countInstructions(ir);
+        m.translated = true;
+
+        for (unsigned i = 0; i < repeat; i++) {
+            ProcessResult result = runProcess({llvm2c, ir, "-o", output});
+            if (result.status != 0) {
+                m.translated = false;
+                break;
+            }
+
+            if (i == 0 || result.seconds < m.seconds) {
+                m.seconds = result.seconds;
+            }
+            if (i == 0 || result.peakRssKB < m.peakRssKB) {
+                m.peakRssKB = result.peakRssKB;
+            }
+        }
+
+        sys::fs::file_size(output, m.outputBytes);
+    }
+
+    sys::fs::remove_directories(dir);
+}
+
+/**
+ * @brief saveCsv Saves measurements in CSV format.
+ */
+static bool saveCsv(const std::string& fileName, const std::vector<Measurement>& measurements) {
+    std::ofstream csv(fileName);
+    if (!csv.is_open()) {
+        return false;
+    }
+
+    csv << "input,opt,translated,instructions,seconds,instructions_per_second,peak_rss_kb,output_bytes\n";
+    for (const auto& m : measurements) {
+        csv << m.input << "," << m.optLevel << "," << m.translated << "," << m.instructions << "," << m.seconds << ","
+            << static_cast<uint64_t>(m.getThroughput()) << "," << m.peakRssKB << "," << m.outputBytes << "\n";
+    }
+
+    return true;
+}
+
+/**
+ * @brief loadCsv Loads measurements saved by saveCsv.
+ * @return Measurements indexed by input and optimization level
+ */
+static std::map<std::pair<std::string, std::string>, Measurement> loadCsv(const std::string& fileName) {
+    std::map<std::pair<std::string, std::string>, Measurement> measurements;
+    std::ifstream csv(fileName);
+    std::string line;
+
+    //the first line is the header
+    std::getline(csv, line);
+    while (std::getline(csv, line)) {
+        std::vector<std::string> fields;
+        std::stringstream stream(line);
+        std::string field;
+        while (std::getline(stream, field, ',')) {
+            fields.push_back(field);
+        }
+
+        if (fields.size() != 8) {
+            continue;
+        }
+
+        Measurement m;
+        m.input = fields[0];
+        m.optLevel = fields[1];
+        m.translated = fields[2] == "1";
+        m.instructions = std::stoull(fields[3]);
+        m.seconds = std::stod(fields[4]);
+        m.peakRssKB = std::stol(fields[6]);
+        m.outputBytes = std::stoull(fields[7]);
+        measurements[{m.input, m.optLevel}] = m;
+    }
+
+    return measurements;
+}
+
+int main(int argc, char** argv) {
+    cl::OptionCategory options("llvm2c-bench options");
+    cl::opt<std::string> Llvm2c("llvm2c", cl::desc("Path to llvm2c"), cl::value_desc("path"), cl::Required, cl::cat(options));
+    cl::opt<std::string> CorpusDir("corpus", cl::desc("Directory with C programs, all C files in its subdirectories are translated"), cl::value_desc("directory"), cl::Required, cl::cat(options));
+    cl::opt<std::string> Clang("clang", cl::desc("C compiler used for compiling the corpus (default clang)"), cl::value_desc("path"), cl::init("clang"), cl::cat(options));
+    cl::list<std::string> OptLevels("O", cl::desc("Optimization levels of the corpus (default 0, 1, 2 and 3)"), cl::value_desc("level"), cl::Prefix, cl::CommaSeparated, cl::cat(options));
+    cl::opt<unsigned> Repeat("repeat", cl::desc("Number of translations of every input, the fastest one is reported (default 3)"), cl::value_desc("N"), cl::init(3), cl::cat(options));
+    cl::opt<std::string> Csv("csv", cl::desc("Saves the measurements in CSV format, the file can be used as a baseline"), cl::value_desc("filename"), cl::cat(options));
+    cl::opt<std::string> Baseline("baseline", cl::desc("Compares the measurements with the baseline saved by --csv"), cl::value_desc("filename"), cl::cat(options));
+    cl::opt<double> Threshold("threshold", cl::desc("Allowed regression against the baseline in percent (default 10)"), cl::value_desc("percent"), cl::init(10), cl::cat(options));
+
+    cl::HideUnrelatedOptions(options);
+    cl::ParseCommandLineOptions(argc, argv);
+
+    auto clang = sys::findProgramByName(Clang);
+    if (!clang) {
+        std::cout << Clang << " not found, benchmark skipped!\n";
+        return SKIP_CODE;
+    }
+
+    SmallString<128> llvm2cPath(Llvm2c);
+    sys::fs::make_absolute(llvm2cPath);
+    std::string llvm2c = llvm2cPath.str().str();
+    if (!sys::fs::can_execute(llvm2c)) {
+        std::cout << "llvm2c not found!\n";
+        return 1;
+    }
+
+    std::vector<std::string> optLevels(OptLevels.begin(), OptLevels.end());
+    if (optLevels.empty()) {
+        optLevels = {"0", "1", "2", "3"};
+    }
+
+    //inputs are measured one after another, parallel runs would distort the times
+    std::vector<Measurement> measurements;
+    unsigned failed = 0;
+    for (const auto& input : getCorpus(CorpusDir)) {
+        for (const auto& level : optLevels) {
+            Measurement m;
+            m.input = input;
+            m.optLevel = "O" + level;
+            measure(m, CorpusDir, llvm2c, *clang, std::max(1u, unsigned(Repeat)));
+
+            if (!m.compiled) {
+                std::cout << "SKIP " << input << " -" << m.optLevel << ": clang could not compile the input\n";
+                continue;
+            }
+
+            if (!m.translated) {
+                std::cout << "FAIL " << input << " -" << m.optLevel << "\n";
+                failed++;
+            } else {
+                std::cout << input << " -" << m.optLevel << ": " << m.instructions << " instructions, " << m.seconds * 1000 << " ms, "
+                          << static_cast<uint64_t>(m.getThroughput()) << " instructions/s, " << m.peakRssKB << " kB peak RSS, "
+                          << m.outputBytes << " bytes\n";
+            }
+            measurements.push_back(m);
+        }
+    }
+
+    if (!Csv.empty() && !saveCsv(Csv, measurements)) {
+        std::cout << "CSV file cannot be opened!\n";
+        return 1;
+    }
+
+    unsigned regressions = 0;
+    if (!Baseline.empty()) {
+        auto baseline = loadCsv(Baseline);
+        if (baseline.empty()) {
+            std::cout << "Baseline " << Baseline << " is empty or cannot be read!\n";
+            return 1;
+        }
+
+        for (const auto& m : measurements) {
+            auto it = baseline.find({m.input, m.optLevel});
+            if (it == baseline.end() || !it->second.translated || !m.translated) {
+                continue;
+            }
+
+            for (const auto& metric : METRICS) {
+                double old = metric.get(it->second);
+                double current = metric.get(m);
+                if (old > metric.minimum && current > old * (1 + Threshold / 100)) {
+                    std::cout << "REGRESSION " << m.input << " -" << m.optLevel << ": " << metric.name << " " << old << " -> " << current
+                              << " (+" << (current / old - 1) * 100 << " %)\n";
+                    regressions++;
+                }
+            }
+        }
+    }
+
+    if (failed || regressions) {
+        std::cout << failed << " inputs failed to translate, " << regressions << " regressions found!\n";
+        return 1;
+    }
+
+    std::cout << "Benchmark finished, " << measurements.size() << " inputs translated.\n";
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include "../core/Compression.h"
+#include "../core/Program.h"
+
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/Verifier.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/BinaryFormat/Magic.h"
+#include "llvm/Object/Archive.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SourceMgr.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+/*
+ * libFuzzer target translating mutated LLVM IR and bitcode, possibly gzip compressed or packed in an archive. Besides crashes, it reports inputs whose output
+ * is disproportionately large compared to the number of their instructions, which indicates exponential
+ * growth of translated expressions. Slow inputs and inputs consuming too much memory are reported by libFuzzer
+ * itself (-timeout and -rss_limit_mb options).
+ */
+
+//the translated program may contain at most this many bytes per LLVM instruction (plus a constant for declarations)
+const static std::size_t MAX_BYTES_PER_INSTRUCTION = 4096;
+const static std::size_t MAX_BYTES_BASE = 1 << 20;
+
+/**
+ * @brief countInstructions Parses and verifies the input, which can be gzip compressed or an archive of bitcode files.
+ * @param buffer Input of llvm2c
+ * @param instructions Number of instructions of the input is added to this counter
+ * @return True if all modules of the input are valid, false otherwise
+ */
+static bool countInstructions(llvm::MemoryBufferRef buffer, std::size_t& instructions) {
+    if (isGzip(buffer.getBuffer())) {
+        try {
+            auto decompressed = decompressGzip(buffer.getBuffer(), "fuzz");
+            return countInstructions(decompressed->getMemBufferRef(), instructions);
+        } catch (std::invalid_argument&) {
+            return false;
+        }
+    }
+
+    if (llvm::identify_magic(buffer.getBuffer()) == llvm::file_magic::archive) {
+        auto archive = llvm::object::Archive::create(buffer);
+        if (!archive) {
+            llvm::consumeError(archive.takeError());
+            return false;
+        }
+
+        bool valid = true;
+        llvm::Error err = llvm::Error::success();
+        for (const auto& child : (*archive)->children(err)) {
+            auto member = child.getMemoryBufferRef();
+            if (!member) {
+                llvm::consumeError(member.takeError());
+                valid = false;
+                break;
+            }
+
+            //llvm2c parses only bitcode members
+            if (llvm::identify_magic(member->getBuffer()) != llvm::file_magic::bitcode || !countInstructions(*member, instructions)) {
+                valid = false;
+                break;
+            }
+        }
+
+        if (err) {
+            llvm::consumeError(std::move(err));
+            return false;
+        }
+        return valid;
+    }
+
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic error;
+    auto module = llvm::parseIR(buffer, error, context);
+    if (!module || llvm::verifyModule(*module)) {
+        return false;
+    }
+
+    for (const llvm::Function& func : module->functions()) {
+        for (const llvm::BasicBlock& block : func) {
+            instructions += block.size();
+        }
+    }
+
+    return true;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, std::size_t size) {
+    //the copy is null terminated, which is required by the IR parser
+    auto buffer = llvm::MemoryBuffer::getMemBufferCopy(llvm::StringRef(reinterpret_cast<const char*>(data), size), "fuzz");
+
+    //llvm2c expects valid modules, invalid ones are not interesting
+    std::size_t instructions = 0;
+    if (!countInstructions(buffer->getMemBufferRef(), instructions)) {
+        return 0;
+    }
+
+    try {
+        Program program(buffer->getMemBufferRef(), false, false);
+        std::ostringstream output;
+        program.print(output);
+
+        std::size_t bytes = output.str().size();
+        if (bytes > MAX_BYTES_BASE + MAX_BYTES_PER_INSTRUCTION * instructions) {
+            std::cerr << "Output of " << bytes << " bytes for " << instructions << " instructions!\n";
+            std::abort();
+        }
+    } catch (std::invalid_argument&) {
+        //unsupported constructs are reported by exceptions
+    }
+
+    return 0;
+}
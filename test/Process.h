@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cerrno>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * @brief The ProcessLimits struct contains resource limits of a child process, 0 means no limit.
+ */
+struct ProcessLimits {
+    unsigned cpuSeconds = 0; //limit of CPU time in seconds
+    unsigned long memoryMB = 0; //limit of address space in MB
+};
+
+/**
+ * @brief The ProcessResult struct contains result of a finished child process.
+ */
+struct ProcessResult {
+    int status = -1; //exit code, 128 + signal number if the process was killed, -1 if it could not be started
+    double seconds = 0; //wall time of the process
+    long peakRssKB = 0; //peak resident set size of the process in kB
+};
+
+/**
+ * @brief runProcess Runs the program and waits until it finishes. The program is searched in PATH.
+ * Standard error output is discarded.
+ * @param args Program and its arguments
+ * @param outputFile File for the standard output, standard output is discarded if empty
+ * @param limits Resource limits of the process
+ * @return Result of the process
+ */
+inline ProcessResult runProcess(const std::vector<std::string>& args, const std::string& outputFile = "", const ProcessLimits& limits = ProcessLimits()) {
+    ProcessResult result;
+
+    //arguments are prepared before fork, only async-signal-safe functions can be used in the child of multithreaded process
+    std::vector<char*> argv;
+    for (const auto& arg : args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+    const char* output = outputFile.empty() ? "/dev/null" : outputFile.c_str();
+
+    auto start = std::chrono::steady_clock::now();
+    pid_t pid = fork();
+    if (pid < 0) {
+        return result;
+    }
+
+    if (pid == 0) {
+        int outFd = open(output, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        int nullFd = open("/dev/null", O_WRONLY);
+        if (outFd < 0 || nullFd < 0 || dup2(outFd, STDOUT_FILENO) < 0 || dup2(nullFd, STDERR_FILENO) < 0) {
+            _exit(127);
+        }
+
+        if (limits.cpuSeconds) {
+            struct rlimit limit = {limits.cpuSeconds, limits.cpuSeconds + 1};
+            setrlimit(RLIMIT_CPU, &limit);
+        }
+
+        if (limits.memoryMB) {
+            struct rlimit limit = {limits.memoryMB * 1024 * 1024, limits.memoryMB * 1024 * 1024};
+            setrlimit(RLIMIT_AS, &limit);
+        }
+
+        execvp(argv[0], argv.data());
+        _exit(127);
+    }
+
+    int status;
+    struct rusage usage;
+    while (wait4(pid, &status, 0, &usage) < 0) {
+        if (errno != EINTR) {
+            return result;
+        }
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.peakRssKB = usage.ru_maxrss;
+    if (WIFEXITED(status)) {
+        result.status = WEXITSTATUS(status);
+    } else if (WIFSIGNALED(status)) {
+        result.status = 128 + WTERMSIG(status);
+    }
+
+    return result;
+}
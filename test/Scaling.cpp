@@ -0,0 +1,273 @@
+#include "Process.h"
+
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace llvm;
+
+/*
+ * Generates LLVM modules of growing size with constructs that are prone to superlinear translation
+ * (deep expression chains, shared subexpressions, nested structs, huge switches, many globals and blocks)
+ * and reports families whose translation time or output size grows faster than the given exponent.
+ */
+
+/**
+ * @brief The Family struct describes a family of generated modules.
+ */
+struct Family {
+    const char* name;
+    unsigned start; //size of the smallest module
+    std::string (*generate)(unsigned size);
+};
+
+/**
+ * @brief generateChain Generates a function with a chain of dependent arithmetic instructions.
+ */
+static std::string generateChain(unsigned size) {
+    const char* ops[] = {"add", "mul", "xor", "sub"};
+    std::stringstream ir;
+    ir << "define i32 @chain(i32 %a) {\n";
+    ir << "  %t0 = add i32 %a, 1\n";
+    for (unsigned i = 1; i < size; i++) {
+        ir << "  %t" << i << " = " << ops[i % 4] << " i32 %t" << i - 1 << ", " << i << "\n";
+    }
+    ir << "  ret i32 %t" << size - 1 << "\n}\n";
+    return ir.str();
+}
+
+/**
+ * @brief generateDag Generates a function in which every instruction uses the previous one twice.
+ */
+static std::string generateDag(unsigned size) {
+    std::stringstream ir;
+    ir << "define i32 @dag(i32 %a) {\n";
+    ir << "  %t0 = add i32 %a, %a\n";
+    for (unsigned i = 1; i < size; i++) {
+        ir << "  %t" << i << " = " << (i % 2 ? "mul" : "add") << " i32 %t" << i - 1 << ", %t" << i - 1 << "\n";
+    }
+    ir << "  ret i32 %t" << size - 1 << "\n}\n";
+    return ir.str();
+}
+
+/**
+ * @brief generateStructs Generates nested structs, an initialized global of the outermost one and access to the innermost one.
+ */
+static std::string generateStructs(unsigned size) {
+    std::stringstream ir;
+    ir << "%struct.s0 = type { i32, i64 }\n";
+    for (unsigned i = 1; i < size; i++) {
+        ir << "%struct.s" << i << " = type { %struct.s" << i - 1 << ", i32 }\n";
+    }
+
+    std::string init = "{ i32 1, i64 2 }";
+    for (unsigned i = 1; i < size; i++) {
+        init = "{ %struct.s" + std::to_string(i - 1) + " " + init + ", i32 " + std::to_string(i) + " }";
+    }
+    std::string type = "%struct.s" + std::to_string(size - 1);
+    ir << "@g = global " << type << " " << init << "\n";
+
+    ir << "define i32 @get() {\n";
+    ir << "  %p = getelementptr " << type << ", " << type << "* @g, i32 0";
+    for (unsigned i = 0; i < size; i++) {
+        ir << ", i32 0";
+    }
+    ir << "\n  %v = load i32, i32* %p\n";
+    ir << "  ret i32 %v\n}\n";
+    return ir.str();
+}
+
+/**
+ * @brief generateSwitch Generates a function with a switch with given number of cases.
+ */
+static std::string generateSwitch(unsigned size) {
+    std::stringstream ir;
+    ir << "define i32 @sw(i32 %x) {\n";
+    ir << "entry:\n  switch i32 %x, label %default [\n";
+    for (unsigned i = 0; i < size; i++) {
+        ir << "    i32 " << i * 3 << ", label %c" << i << "\n";
+    }
+    ir << "  ]\n";
+    for (unsigned i = 0; i < size; i++) {
+        ir << "c" << i << ":\n  ret i32 " << i * 7 << "\n";
+    }
+    ir << "default:\n  ret i32 -1\n}\n";
+    return ir.str();
+}
+
+/**
+ * @brief generateGlobals Generates global variables and functions, each function reads one variable.
+ */
+static std::string generateGlobals(unsigned size) {
+    std::stringstream ir;
+    for (unsigned i = 0; i < size; i++) {
+        ir << "@g" << i << " = global i32 " << i << "\n";
+    }
+    for (unsigned i = 0; i < size; i++) {
+        ir << "define i32 @f" << i << "() {\n";
+        ir << "  %v = load i32, i32* @g" << i << "\n";
+        ir << "  ret i32 %v\n}\n";
+    }
+    return ir.str();
+}
+
+/**
+ * @brief generateBlocks Generates a function with a chain of conditional branches.
+ */
+static std::string generateBlocks(unsigned size) {
+    std::stringstream ir;
+    ir << "define i32 @blocks(i32 %x) {\n";
+    ir << "entry:\n  br label %b0\n";
+    for (unsigned i = 0; i < size; i++) {
+        ir << "b" << i << ":\n";
+        ir << "  %c" << i << " = icmp sgt i32 %x, " << i << "\n";
+        ir << "  br i1 %c" << i << ", label %b" << i + 1 << ", label %exit\n";
+    }
+    ir << "b" << size << ":\n  ret i32 1\n";
+    ir << "exit:\n  ret i32 0\n}\n";
+    return ir.str();
+}
+
+const static Family FAMILIES[] = {
+    {"expression-chain", 500, generateChain},
+    {"expression-dag", 8, generateDag},
+    {"nested-structs", 50, generateStructs},
+    {"switch", 500, generateSwitch},
+    {"globals", 250, generateGlobals},
+    {"blocks", 250, generateBlocks},
+};
+
+/**
+ * @brief The Sample struct contains measurement of translation of one generated module.
+ */
+struct Sample {
+    unsigned size;
+    ProcessResult result;
+    uint64_t outputBytes = 0;
+};
+
+/**
+ * @brief getExponent Returns exponent of growth between two measurements, e.g. 2 for quadratic growth.
+ */
+static double getExponent(double value1, double value2, unsigned size1, unsigned size2) {
+    if (value1 <= 0 || value2 <= 0) {
+        return 0;
+    }
+    return std::log(value2 / value1) / std::log(static_cast<double>(size2) / size1);
+}
+
+int main(int argc, char** argv) {
+    cl::OptionCategory options("llvm2c-scaling options");
+    cl::opt<std::string> Llvm2c("llvm2c", cl::desc("Path to llvm2c"), cl::value_desc("path"), cl::Required, cl::cat(options));
+    cl::list<std::string> Families("family", cl::desc("Families of generated modules (default all)"), cl::value_desc("name"), cl::CommaSeparated, cl::cat(options));
+    cl::opt<unsigned> Steps("steps", cl::desc("Number of sizes of every family, the size is doubled in every step (default 4)"), cl::value_desc("N"), cl::init(4), cl::cat(options));
+    cl::opt<double> MaxExponent("max-exponent", cl::desc("Maximal allowed exponent of growth of time and output size (default 1.5)"), cl::value_desc("exponent"), cl::init(1.5), cl::cat(options));
+    cl::opt<double> MinSeconds("min-seconds", cl::desc("Growth of time is checked only for translations longer than this (default 0.05)"), cl::value_desc("seconds"), cl::init(0.05), cl::cat(options));
+    cl::opt<unsigned> TimeLimit("time-limit", cl::desc("CPU time limit of one translation in seconds (default 60)"), cl::value_desc("seconds"), cl::init(60), cl::cat(options));
+    cl::opt<unsigned> MemoryLimit("memory-limit", cl::desc("Memory limit of one translation in MB (default 4096)"), cl::value_desc("MB"), cl::init(4096), cl::cat(options));
+    cl::opt<std::string> Keep("keep", cl::desc("Saves the largest module of every flagged family into the directory"), cl::value_desc("directory"), cl::cat(options));
+
+    cl::HideUnrelatedOptions(options);
+    cl::ParseCommandLineOptions(argc, argv);
+
+    SmallString<128> llvm2cPath(Llvm2c);
+    sys::fs::make_absolute(llvm2cPath);
+    std::string llvm2c = llvm2cPath.str().str();
+    if (!sys::fs::can_execute(llvm2c)) {
+        std::cout << "llvm2c not found!\n";
+        return 1;
+    }
+
+    SmallString<128> tempDir;
+    if (sys::fs::createUniqueDirectory("llvm2c-scaling", tempDir)) {
+        std::cout << "Temporary directory cannot be created!\n";
+        return 1;
+    }
+    std::string dir = tempDir.str().str();
+
+    ProcessLimits limits;
+    limits.cpuSeconds = TimeLimit;
+    limits.memoryMB = MemoryLimit;
+
+    unsigned flagged = 0;
+    unsigned tested = 0;
+    for (const auto& family : FAMILIES) {
+        if (!Families.empty() && std::find(Families.begin(), Families.end(), family.name) == Families.end()) {
+            continue;
+        }
+        tested++;
+
+        std::cout << family.name << ":\n";
+        std::vector<Sample> samples;
+        std::string problem;
+        std::string input = dir + "/" + family.name + ".ll";
+
+        for (unsigned step = 0, size = family.start; step < Steps; step++, size *= 2) {
+            std::ofstream(input) << family.generate(size);
+
+            Sample sample;
+            sample.size = size;
+            sample.result = runProcess({llvm2c, input, "-o", dir + "/output.c"}, "", limits);
+            sys::fs::file_size(dir + "/output.c", sample.outputBytes);
+            sys::fs::remove(dir + "/output.c");
+
+            std::cout << "  size " << size << ": " << sample.result.seconds << " s, " << sample.result.peakRssKB / 1024 << " MB peak RSS, "
+                      << sample.outputBytes << " bytes";
+
+            if (sample.result.status != 0) {
+                std::cout << "\n";
+                problem = "translation failed or exceeded limits (status " + std::to_string(sample.result.status) + ")";
+                break;
+            }
+
+            if (!samples.empty()) {
+                const Sample& last = samples.back();
+                double timeExponent = getExponent(last.result.seconds, sample.result.seconds, last.size, size);
+                double sizeExponent = getExponent(last.outputBytes, sample.outputBytes, last.size, size);
+                std::cout << ", time exponent " << timeExponent << ", output exponent " << sizeExponent;
+
+                //only the largest pair decides, growth of small inputs is dominated by constant costs
+                if (step + 1 == Steps) {
+                    if (last.result.seconds >= MinSeconds && timeExponent > MaxExponent) {
+                        problem = "time grows superlinearly";
+                    } else if (sizeExponent > MaxExponent) {
+                        problem = "output size grows superlinearly";
+                    }
+                }
+            }
+            std::cout << "\n";
+            samples.push_back(sample);
+        }
+
+        if (!problem.empty()) {
+            std::cout << "FLAGGED " << family.name << ": " << problem << "\n";
+            flagged++;
+
+            if (!Keep.empty()) {
+                sys::fs::create_directories(Keep);
+                sys::fs::copy_file(input, Keep + "/" + family.name + ".ll");
+            }
+        }
+    }
+
+    sys::fs::remove_directories(dir);
+
+    if (tested == 0) {
+        std::cout << "No family selected!\n";
+        return 1;
+    }
+
+    if (flagged) {
+        std::cout << flagged << " of " << tested << " families flagged!\n";
+        return 1;
+    }
+
+    std::cout << "All " << tested << " families scale linearly.\n";
+    return 0;
+}
@@ -0,0 +1,448 @@
+#include "Process.h"
+
+#include "llvm/Object/ArchiveWriter.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Program.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+using namespace llvm;
+
+//exit code that tells CTest that the test was skipped
+const static int SKIP_CODE = 77;
+
+/**
+ * @brief The TestMode enum describes how the original and the translated programs are run and compared.
+ */
+enum TestMode {
+    ONE_ARG, //exit codes are compared for inputs -10..10
+    TWO_ARGS, //exit codes are compared for inputs (-10, -5)..(10, 15)
+    NO_ARGS, //exit codes are compared
+    OUTPUT //exit codes and standard outputs are compared
+};
+
+/**
+ * @brief The TestSuite struct describes a directory (or a single file) of tests.
+ */
+struct TestSuite {
+    const char* path; //path relative to the test directory
+    TestMode mode;
+    bool math; //programs are linked with libm
+};
+
+const static TestSuite SUITES[] = {
+    {"loops", ONE_ARG, false},
+    {"math/math_single_arg", ONE_ARG, false},
+    {"math/math_two_args", TWO_ARGS, false},
+    {"asm/basic_add.c", TWO_ARGS, false},
+    {"asm/multiple_asm.c", TWO_ARGS, false},
+    {"asm/mov.c", NO_ARGS, false},
+    {"struct", ONE_ARG, false},
+    {"pointer", ONE_ARG, false},
+    {"branching", ONE_ARG, false},
+    {"statements", ONE_ARG, false},
+    {"standard_lib", OUTPUT, true},
+    {"input", ONE_ARG, false},
+};
+
+/**
+ * @brief The TestDirectives struct contains directives written in comments of the test, e.g. "// CHECK: text" in C
+ * or "; CHECK: text" in LLVM IR.
+ */
+struct TestDirectives {
+    std::vector<std::string> checks; //CHECK: text that must be in the translated file
+    std::vector<std::string> checkNots; //CHECK-NOT: text that must not be in the translated file
+    std::vector<std::string> cflags; //CFLAGS: flags used for compiling the translated file
+    std::vector<std::string> links; //LINK: sources linked with the test, translated as separate inputs
+    std::vector<std::string> archives; //ARCHIVE: sources packed into an archive given after the other inputs
+    bool gzip = false; //GZIP: the IR is translated gzip compressed into a compressed output
+    unsigned gzipPadding = 0; //number of zero bytes appended to the compressed IR, given by the GZIP directive
+};
+
+/**
+ * @brief The TestJob struct is one test compiled with one optimization level.
+ */
+struct TestJob {
+    std::string file; //path relative to the test directory
+    const TestSuite* suite;
+    std::string optLevel;
+
+    //results
+    bool passed = false;
+    std::string message;
+    double translationSeconds = 0;
+    uint64_t outputBytes = 0;
+};
+
+/**
+ * @brief readFile Returns content of the file, or empty string if the file cannot be read.
+ */
+static std::string readFile(const std::string& fileName) {
+    auto buffer = MemoryBuffer::getFile(fileName);
+    return buffer ? (*buffer)->getBuffer().str() : "";
+}
+
+/**
+ * @brief readDirectives Parses directives from comments of the test.
+ */
+/**
+ * @brief splitWords Appends words of the directive separated by spaces.
+ */
+static void splitWords(StringRef text, std::vector<std::string>& words) {
+    SmallVector<StringRef, 4> parts;
+    text.split(parts, ' ', -1, false);
+    for (const auto& part : parts) {
+        words.push_back(part.str());
+    }
+}
+
+static TestDirectives readDirectives(const std::string& fileName) {
+    TestDirectives directives;
+    std::istringstream source(readFile(fileName));
+    std::string line;
+    while (std::getline(source, line)) {
+        StringRef text = StringRef(line).trim();
+        if (!text.consume_front("//") && !text.consume_front(";")) {
+            continue;
+        }
+        text = text.trim();
+
+        if (text.consume_front("CHECK:")) {
+            directives.checks.push_back(text.trim().str());
+        } else if (text.consume_front("CHECK-NOT:")) {
+            directives.checkNots.push_back(text.trim().str());
+        } else if (text.consume_front("CFLAGS:")) {
+            splitWords(text, directives.cflags);
+        } else if (text.consume_front("LINK:")) {
+            splitWords(text, directives.links);
+        } else if (text.consume_front("ARCHIVE:")) {
+            splitWords(text, directives.archives);
+        } else if (text.consume_front("GZIP:")) {
+            directives.gzip = true;
+            text.trim().getAsInteger(10, directives.gzipPadding);
+        }
+    }
+
+    return directives;
+}
+
+/**
+ * @brief checkOutput Checks the CHECK and CHECK-NOT directives against the translated file.
+ * @return Empty string if the translated file passes, description of the failed directive otherwise
+ */
+static std::string checkOutput(const TestDirectives& directives, const std::string& translated) {
+    std::string output = readFile(translated);
+    for (const auto& check : directives.checks) {
+        if (output.find(check) == std::string::npos) {
+            return "translated file does not contain \"" + check + "\"";
+        }
+    }
+    for (const auto& check : directives.checkNots) {
+        if (output.find(check) != std::string::npos) {
+            return "translated file contains \"" + check + "\"";
+        }
+    }
+
+    return "";
+}
+
+/**
+ * @brief createArchive Packs the files into an archive.
+ * @param symbolTable Whether the archive contains a symbol table, which is needed by the system linker
+ * @return True if the archive was written, false otherwise
+ */
+static bool createArchive(const std::string& archive, const std::vector<std::string>& files, bool symbolTable) {
+    std::vector<NewArchiveMember> members;
+    for (const auto& file : files) {
+        auto member = NewArchiveMember::getFile(file, true);
+        if (!member) {
+            consumeError(member.takeError());
+            return false;
+        }
+        members.push_back(std::move(*member));
+    }
+
+    if (Error err = writeArchive(archive, members, symbolTable, object::Archive::K_GNU, true, false)) {
+        consumeError(std::move(err));
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief compressFile Compresses the file by gzip and appends zero bytes to the compressed file.
+ * @param padding Number of appended zero bytes
+ * @return True if the file was compressed, false otherwise
+ */
+static bool compressFile(const std::string& file, const std::string& compressed, unsigned padding) {
+    if (runProcess({"gzip", "-c", "-n", file}, compressed).status != 0) {
+        return false;
+    }
+
+    std::ofstream stream(compressed, std::ios::binary | std::ios::app);
+    stream << std::string(padding, '\0');
+    return static_cast<bool>(stream);
+}
+
+/**
+ * @brief getInputs Returns command line arguments used for running the test programs.
+ */
+static std::vector<std::vector<std::string>> getInputs(TestMode mode) {
+    std::vector<std::vector<std::string>> inputs;
+    switch (mode) {
+    case ONE_ARG:
+        for (int i = -10; i <= 10; i++) {
+            inputs.push_back({std::to_string(i)});
+        }
+        break;
+    case TWO_ARGS:
+        for (int i = -10; i <= 10; i++) {
+            inputs.push_back({std::to_string(i), std::to_string(i + 5)});
+        }
+        break;
+    default:
+        inputs.push_back({});
+    }
+
+    return inputs;
+}
+
+/**
+ * @brief runTest Runs the translate -> compile -> execute -> compare cycle of one test in its own temporary directory.
+ */
+static void runTest(TestJob& job, const std::string& testDir, const std::string& llvm2c, const std::string& clang) {
+    SmallString<128> tempDir;
+    if (sys::fs::createUniqueDirectory("llvm2c-test", tempDir)) {
+        job.message = "cannot create temporary directory";
+        return;
+    }
+    std::string dir = tempDir.str().str();
+
+    std::string source = testDir + "/" + job.file;
+    std::string orig = dir + "/orig";
+    std::string ir = dir + "/temp.ll";
+    std::string translated = dir + "/temp.c";
+    std::string binary = dir + "/new";
+
+    TestDirectives directives = readDirectives(source);
+
+    std::vector<std::string> link;
+    if (job.suite->math) {
+        link.push_back("-lm");
+    }
+
+    auto compile = [&](const std::vector<std::string>& args) {
+        std::vector<std::string> command = {clang, "-" + job.optLevel};
+        command.insert(command.end(), args.begin(), args.end());
+        command.insert(command.end(), link.begin(), link.end());
+        return runProcess(command).status == 0;
+    };
+
+    //the original program is linked from the same sources, archive members are compiled both to objects and to bitcode
+    auto compileInputs = [&](std::vector<std::string>& origArgs, std::vector<std::string>& translationArgs) {
+        std::string sourceDir = sys::path::parent_path(source).str();
+        for (size_t i = 0; i < directives.links.size(); i++) {
+            std::string linked = sourceDir + "/" + directives.links[i];
+            std::string linkedIr = dir + "/link" + std::to_string(i) + ".ll";
+            if (!compile({linked, "-emit-llvm", "-S", "-o", linkedIr})) {
+                return false;
+            }
+            origArgs.push_back(linked);
+            translationArgs.push_back(linkedIr);
+        }
+
+        std::vector<std::string> objects;
+        std::vector<std::string> bitcodes;
+        for (size_t i = 0; i < directives.archives.size(); i++) {
+            std::string member = sourceDir + "/" + directives.archives[i];
+            objects.push_back(dir + "/member" + std::to_string(i) + ".o");
+            bitcodes.push_back(dir + "/member" + std::to_string(i) + ".bc");
+            if (!compile({"-c", member, "-o", objects.back()}) || !compile({"-c", member, "-emit-llvm", "-o", bitcodes.back()})) {
+                return false;
+            }
+        }
+
+        if (!directives.archives.empty()) {
+            if (!createArchive(dir + "/lib.a", objects, true) || !createArchive(dir + "/lib.bc.a", bitcodes, false)) {
+                return false;
+            }
+            origArgs.push_back(dir + "/lib.a");
+            translationArgs.push_back(dir + "/lib.bc.a");
+        }
+
+        origArgs.insert(origArgs.end(), {"-o", orig});
+        return compile(origArgs) && compile({source, "-emit-llvm", "-S", "-o", ir});
+    };
+
+    //compressed output is decompressed by gzip before it is checked and compiled
+    std::string output = directives.gzip ? translated + ".gz" : translated;
+    std::vector<std::string> origArgs = {source};
+    std::vector<std::string> translationArgs = {llvm2c, directives.gzip ? ir + ".gz" : ir};
+    if (!compileInputs(origArgs, translationArgs)) {
+        job.message = "clang could not compile the test";
+    } else if (directives.gzip && !compressFile(ir, ir + ".gz", directives.gzipPadding)) {
+        job.message = "gzip could not compress the test";
+    } else {
+        translationArgs.insert(translationArgs.end(), {"-o", output});
+        ProcessResult translation = runProcess(translationArgs);
+        job.translationSeconds = translation.seconds;
+        bool decompressed = !directives.gzip || translation.status != 0 || runProcess({"gzip", "-d", "-c", output}, translated).status == 0;
+        sys::fs::file_size(translated, job.outputBytes);
+
+        std::vector<std::string> translatedArgs = directives.cflags;
+        translatedArgs.insert(translatedArgs.end(), {translated, "-o", binary});
+        std::string checkMessage = translation.status == 0 && decompressed ? checkOutput(directives, translated) : "";
+
+        if (translation.status != 0) {
+            job.message = "llvm2c failed to translate the test";
+        } else if (!decompressed) {
+            job.message = "gzip could not decompress the translated file";
+        } else if (!checkMessage.empty()) {
+            job.message = checkMessage;
+        } else if (!compile(translatedArgs)) {
+            job.message = "clang could not compile the translated file";
+        } else {
+            job.passed = true;
+            for (const auto& input : getInputs(job.suite->mode)) {
+                std::vector<std::string> origCommand = {orig};
+                std::vector<std::string> newCommand = {binary};
+                origCommand.insert(origCommand.end(), input.begin(), input.end());
+                newCommand.insert(newCommand.end(), input.begin(), input.end());
+
+                std::string origOutput = job.suite->mode == OUTPUT ? dir + "/orig_output" : "";
+                std::string newOutput = job.suite->mode == OUTPUT ? dir + "/new_output" : "";
+                ProcessLimits limits;
+                limits.cpuSeconds = 10;
+
+                int origStatus = runProcess(origCommand, origOutput, limits).status;
+                int newStatus = runProcess(newCommand, newOutput, limits).status;
+
+                if (origStatus != newStatus || (job.suite->mode == OUTPUT && readFile(origOutput) != readFile(newOutput))) {
+                    std::string args;
+                    for (const auto& arg : input) {
+                        args += " " + arg;
+                    }
+                    job.message = "failed with input" + (args.empty() ? " (none)" : args);
+                    job.passed = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    sys::fs::remove_directories(dir);
+}
+
+int main(int argc, char** argv) {
+    cl::OptionCategory options("llvm2c-test options");
+    cl::opt<std::string> Llvm2c("llvm2c", cl::desc("Path to llvm2c"), cl::value_desc("path"), cl::Required, cl::cat(options));
+    cl::opt<std::string> TestDir("tests", cl::desc("Directory containing tests"), cl::value_desc("directory"), cl::Required, cl::cat(options));
+    cl::opt<std::string> Clang("clang", cl::desc("C compiler used for compiling the tests (default clang)"), cl::value_desc("path"), cl::init("clang"), cl::cat(options));
+    cl::list<std::string> OptLevels("O", cl::desc("Optimization levels of the tests (default 0, 1, 2 and 3)"), cl::value_desc("level"), cl::Prefix, cl::CommaSeparated, cl::cat(options));
+    cl::opt<unsigned> Jobs("j", cl::desc("Number of tests run in parallel (default number of CPUs)"), cl::value_desc("N"), cl::cat(options));
+    cl::opt<std::string> Csv("csv", cl::desc("Saves results of the tests in CSV format"), cl::value_desc("filename"), cl::cat(options));
+
+    cl::HideUnrelatedOptions(options);
+    cl::ParseCommandLineOptions(argc, argv);
+
+    auto clang = sys::findProgramByName(Clang);
+    if (!clang) {
+        std::cout << Clang << " not found, tests skipped!\n";
+        return SKIP_CODE;
+    }
+
+    //tests are run in temporary directories
+    SmallString<128> llvm2cPath(Llvm2c);
+    sys::fs::make_absolute(llvm2cPath);
+    std::string llvm2c = llvm2cPath.str().str();
+    if (!sys::fs::can_execute(llvm2c)) {
+        std::cout << "llvm2c not found!\n";
+        return 1;
+    }
+
+    std::vector<std::string> optLevels(OptLevels.begin(), OptLevels.end());
+    if (optLevels.empty()) {
+        optLevels = {"0", "1", "2", "3"};
+    }
+
+    std::vector<TestJob> jobs;
+    for (const auto& suite : SUITES) {
+        std::vector<std::string> files;
+        std::string path = TestDir + "/" + suite.path;
+
+        if (sys::fs::is_directory(path)) {
+            std::error_code ec;
+            for (sys::fs::directory_iterator it(path, ec), end; it != end && !ec; it.increment(ec)) {
+                //handwritten LLVM IR is used for constructs that clang does not generate reliably
+                if (StringRef(it->path()).endswith(".c") || StringRef(it->path()).endswith(".ll")) {
+                    files.push_back(std::string(suite.path) + "/" + sys::path::filename(it->path()).str());
+                }
+            }
+            std::sort(files.begin(), files.end());
+        } else {
+            files.push_back(suite.path);
+        }
+
+        for (const auto& file : files) {
+            for (const auto& level : optLevels) {
+                TestJob job;
+                job.file = file;
+                job.suite = &suite;
+                job.optLevel = "O" + level;
+                jobs.push_back(job);
+            }
+        }
+    }
+
+    unsigned threadCount = Jobs ? Jobs : std::max(1u, std::thread::hardware_concurrency());
+    std::atomic<size_t> next(0);
+    std::mutex outputMutex;
+    std::vector<std::thread> threads;
+
+    for (unsigned i = 0; i < threadCount; i++) {
+        threads.emplace_back([&]() {
+            for (size_t index = next++; index < jobs.size(); index = next++) {
+                TestJob& job = jobs[index];
+                runTest(job, TestDir, llvm2c, *clang);
+
+                std::lock_guard<std::mutex> lock(outputMutex);
+                std::cout << (job.passed ? "PASS " : "FAIL ") << job.file << " -" << job.optLevel;
+                if (!job.passed) {
+                    std::cout << ": " << job.message;
+                }
+                std::cout << " (translation " << job.translationSeconds * 1000 << " ms, " << job.outputBytes << " bytes)\n";
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (!Csv.empty()) {
+        std::ofstream csv(Csv);
+        csv << "test,opt,passed,translation_seconds,output_bytes\n";
+        for (const auto& job : jobs) {
+            csv << job.file << "," << job.optLevel << "," << job.passed << "," << job.translationSeconds << "," << job.outputBytes << "\n";
+        }
+    }
+
+    unsigned failed = std::count_if(jobs.begin(), jobs.end(), [](const TestJob& job) { return !job.passed; });
+    if (failed == 0) {
+        std::cout << "All " << jobs.size() << " tests passed!\n";
+        return 0;
+    }
+
+    std::cout << failed << " of " << jobs.size() << " tests failed!\n";
+    return 1;
+}
@@ -0,0 +1,376 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Stack based bytecode interpreter with a small assembler. */
+
+enum Opcode {
+	OP_PUSH,
+	OP_POP,
+	OP_DUP,
+	OP_SWAP,
+	OP_OVER,
+	OP_ADD,
+	OP_SUB,
+	OP_MUL,
+	OP_DIV,
+	OP_MOD,
+	OP_NEG,
+	OP_AND,
+	OP_OR,
+	OP_XOR,
+	OP_NOT,
+	OP_SHL,
+	OP_SHR,
+	OP_EQ,
+	OP_NE,
+	OP_LT,
+	OP_LE,
+	OP_GT,
+	OP_GE,
+	OP_JMP,
+	OP_JZ,
+	OP_JNZ,
+	OP_LOAD,
+	OP_STORE,
+	OP_CALL,
+	OP_RET,
+	OP_PRINT,
+	OP_HALT,
+	OP_COUNT
+};
+
+struct Instruction {
+	enum Opcode op;
+	long arg;
+};
+
+struct Frame {
+	int returnAddress;
+	int base;
+};
+
+struct VM {
+	struct Instruction *code;
+	int codeSize;
+	long stack[1024];
+	int sp;
+	long memory[256];
+	struct Frame frames[64];
+	int fp;
+	long steps;
+	unsigned checksum;
+};
+
+static const char *names[OP_COUNT] = {
+	"push", "pop", "dup", "swap", "over", "add", "sub", "mul", "div", "mod", "neg",
+	"and", "or", "xor", "not", "shl", "shr", "eq", "ne", "lt", "le", "gt", "ge",
+	"jmp", "jz", "jnz", "load", "store", "call", "ret", "print", "halt"
+};
+
+static int hasArgument(enum Opcode op) {
+	switch (op) {
+	case OP_PUSH:
+	case OP_JMP:
+	case OP_JZ:
+	case OP_JNZ:
+	case OP_LOAD:
+	case OP_STORE:
+	case OP_CALL:
+		return 1;
+	default:
+		return 0;
+	}
+}
+
+static int assemble(const char *source, struct Instruction *code, int capacity) {
+	char line[128];
+	int count = 0;
+
+	while (*source && count < capacity) {
+		int length = 0;
+		while (*source && *source != '\n' && length < 127) {
+			line[length++] = *source++;
+		}
+		line[length] = '\0';
+		if (*source == '\n') {
+			source++;
+		}
+
+		char name[16];
+		long arg = 0;
+		int fields = sscanf(line, "%15s %ld", name, &arg);
+		if (fields <= 0) {
+			continue;
+		}
+
+		int op;
+		for (op = 0; op < OP_COUNT; op++) {
+			if (strcmp(names[op], name) == 0) {
+				break;
+			}
+		}
+
+		if (op == OP_COUNT || (hasArgument((enum Opcode) op) && fields != 2)) {
+			return -1;
+		}
+
+		code[count].op = (enum Opcode) op;
+		code[count].arg = arg;
+		count++;
+	}
+
+	return count;
+}
+
+static long pop(struct VM *vm) {
+	if (vm->sp == 0) {
+		return 0;
+	}
+	return vm->stack[--vm->sp];
+}
+
+static void push(struct VM *vm, long value) {
+	if (vm->sp < 1024) {
+		vm->stack[vm->sp++] = value;
+	}
+}
+
+static int run(struct VM *vm, long maxSteps) {
+	int pc = 0;
+	long a, b;
+
+	while (pc >= 0 && pc < vm->codeSize && vm->steps < maxSteps) {
+		struct Instruction *ins = &vm->code[pc++];
+		vm->steps++;
+
+		switch (ins->op) {
+		case OP_PUSH:
+			push(vm, ins->arg);
+			break;
+		case OP_POP:
+			pop(vm);
+			break;
+		case OP_DUP:
+			a = pop(vm);
+			push(vm, a);
+			push(vm, a);
+			break;
+		case OP_SWAP:
+			a = pop(vm);
+			b = pop(vm);
+			push(vm, a);
+			push(vm, b);
+			break;
+		case OP_OVER:
+			a = pop(vm);
+			b = pop(vm);
+			push(vm, b);
+			push(vm, a);
+			push(vm, b);
+			break;
+		case OP_ADD:
+			b = pop(vm);
+			push(vm, pop(vm) + b);
+			break;
+		case OP_SUB:
+			b = pop(vm);
+			push(vm, pop(vm) - b);
+			break;
+		case OP_MUL:
+			b = pop(vm);
+			push(vm, pop(vm) * b);
+			break;
+		case OP_DIV:
+			b = pop(vm);
+			a = pop(vm);
+			push(vm, b == 0 ? 0 : a / b);
+			break;
+		case OP_MOD:
+			b = pop(vm);
+			a = pop(vm);
+			push(vm, b == 0 ? 0 : a % b);
+			break;
+		case OP_NEG:
+			push(vm, -pop(vm));
+			break;
+		case OP_AND:
+			b = pop(vm);
+			push(vm, pop(vm) & b);
+			break;
+		case OP_OR:
+			b = pop(vm);
+			push(vm, pop(vm) | b);
+			break;
+		case OP_XOR:
+			b = pop(vm);
+			push(vm, pop(vm) ^ b);
+			break;
+		case OP_NOT:
+			push(vm, ~pop(vm));
+			break;
+		case OP_SHL:
+			b = pop(vm);
+			push(vm, pop(vm) << (b & 63));
+			break;
+		case OP_SHR:
+			b = pop(vm);
+			push(vm, (long) ((unsigned long) pop(vm) >> (b & 63)));
+			break;
+		case OP_EQ:
+			b = pop(vm);
+			push(vm, pop(vm) == b);
+			break;
+		case OP_NE:
+			b = pop(vm);
+			push(vm, pop(vm) != b);
+			break;
+		case OP_LT:
+			b = pop(vm);
+			push(vm, pop(vm) < b);
+			break;
+		case OP_LE:
+			b = pop(vm);
+			push(vm, pop(vm) <= b);
+			break;
+		case OP_GT:
+			b = pop(vm);
+			push(vm, pop(vm) > b);
+			break;
+		case OP_GE:
+			b = pop(vm);
+			push(vm, pop(vm) >= b);
+			break;
+		case OP_JMP:
+			pc = (int) ins->arg;
+			break;
+		case OP_JZ:
+			if (pop(vm) == 0) {
+				pc = (int) ins->arg;
+			}
+			break;
+		case OP_JNZ:
+			if (pop(vm) != 0) {
+				pc = (int) ins->arg;
+			}
+			break;
+		case OP_LOAD:
+			push(vm, vm->memory[ins->arg & 255]);
+			break;
+		case OP_STORE:
+			vm->memory[ins->arg & 255] = pop(vm);
+			break;
+		case OP_CALL:
+			if (vm->fp == 64) {
+				return -2;
+			}
+			vm->frames[vm->fp].returnAddress = pc;
+			vm->frames[vm->fp].base = vm->sp;
+			vm->fp++;
+			pc = (int) ins->arg;
+			break;
+		case OP_RET:
+			if (vm->fp == 0) {
+				return 0;
+			}
+			pc = vm->frames[--vm->fp].returnAddress;
+			break;
+		case OP_PRINT:
+			a = pop(vm);
+			vm->checksum = vm->checksum * 31 + (unsigned) a;
+			printf("%ld\n", a);
+			break;
+		case OP_HALT:
+			return 0;
+		default:
+			return -1;
+		}
+	}
+
+	return vm->steps < maxSteps ? 0 : -3;
+}
+
+/* prints primes below 200 and the 25th fibonacci number computed recursively */
+static const char *program =
+	"push 2\n"          /* 0 */
+	"store 0\n"         /* 1: n = 2 */
+	"load 0\n"          /* 2 */
+	"push 200\n"
+	"lt\n"
+	"jz 30\n"           /* 5 */
+	"push 2\n"
+	"store 1\n"         /* 7: d = 2 */
+	"load 1\n"          /* 8 */
+	"dup\n"
+	"mul\n"
+	"load 0\n"
+	"gt\n"
+	"jnz 23\n"          /* 13: d * d > n -> prime */
+	"load 0\n"
+	"load 1\n"
+	"mod\n"
+	"jz 25\n"           /* 17: divisible -> next */
+	"load 1\n"
+	"push 1\n"
+	"add\n"
+	"store 1\n"
+	"jmp 8\n"           /* 22 */
+	"load 0\n"          /* 23 */
+	"print\n"
+	"load 0\n"          /* 25 */
+	"push 1\n"
+	"add\n"
+	"store 0\n"
+	"jmp 2\n"
+	"push 25\n"         /* 30 */
+	"store 2\n"
+	"call 35\n"
+	"print\n"
+	"halt\n"
+	"load 2\n"          /* 35: fib(memory[2]) */
+	"push 2\n"
+	"lt\n"
+	"jz 41\n"
+	"load 2\n"
+	"ret\n"
+	"load 2\n"          /* 41 */
+	"push 1\n"
+	"sub\n"
+	"store 2\n"
+	"call 35\n"
+	"load 2\n"
+	"push 1\n"
+	"add\n"
+	"store 2\n"
+	"load 2\n"
+	"push 2\n"
+	"sub\n"
+	"store 2\n"
+	"call 35\n"
+	"load 2\n"
+	"push 2\n"
+	"add\n"
+	"store 2\n"
+	"add\n"
+	"ret\n";
+
+int main(void) {
+	struct Instruction code[256];
+	struct VM *vm = calloc(1, sizeof(struct VM));
+	if (!vm) {
+		return 1;
+	}
+
+	vm->code = code;
+	vm->codeSize = assemble(program, code, 256);
+	if (vm->codeSize < 0) {
+		free(vm);
+		return 2;
+	}
+
+	int status = run(vm, 100000000);
+	unsigned checksum = vm->checksum;
+	free(vm);
+
+	return status == 0 ? (int) (checksum % 128) : 3;
+}
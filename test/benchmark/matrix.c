@@ -0,0 +1,178 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Solves linear systems by LU decomposition with partial pivoting and checks the residuals. */
+
+#define N 48
+
+struct Matrix {
+	unsigned rows;
+	unsigned cols;
+	double data[N][N];
+};
+
+struct Decomposition {
+	struct Matrix lu;
+	unsigned pivot[N];
+	int sign;
+};
+
+static unsigned long seed = 12345;
+
+static double nextRandom(void) {
+	seed = seed * 6364136223846793005ul + 1442695040888963407ul;
+	return (double) (seed >> 11) / 9007199254740992.0 - 0.5;
+}
+
+static void fill(struct Matrix *m, unsigned rows, unsigned cols) {
+	m->rows = rows;
+	m->cols = cols;
+	for (unsigned i = 0; i < rows; i++) {
+		for (unsigned j = 0; j < cols; j++) {
+			m->data[i][j] = nextRandom();
+		}
+		/* diagonal dominance keeps the system well conditioned */
+		if (i < cols) {
+			m->data[i][i] += rows;
+		}
+	}
+}
+
+static void multiply(const struct Matrix *a, const struct Matrix *b, struct Matrix *result) {
+	result->rows = a->rows;
+	result->cols = b->cols;
+	for (unsigned i = 0; i < a->rows; i++) {
+		for (unsigned j = 0; j < b->cols; j++) {
+			double sum = 0;
+			for (unsigned k = 0; k < a->cols; k++) {
+				sum += a->data[i][k] * b->data[k][j];
+			}
+			result->data[i][j] = sum;
+		}
+	}
+}
+
+static int decompose(const struct Matrix *m, struct Decomposition *d) {
+	unsigned n = m->rows;
+	d->lu = *m;
+	d->sign = 1;
+	for (unsigned i = 0; i < n; i++) {
+		d->pivot[i] = i;
+	}
+
+	for (unsigned k = 0; k < n; k++) {
+		unsigned best = k;
+		for (unsigned i = k + 1; i < n; i++) {
+			if (fabs(d->lu.data[i][k]) > fabs(d->lu.data[best][k])) {
+				best = i;
+			}
+		}
+
+		if (fabs(d->lu.data[best][k]) < 1e-12) {
+			return 0;
+		}
+
+		if (best != k) {
+			for (unsigned j = 0; j < n; j++) {
+				double tmp = d->lu.data[k][j];
+				d->lu.data[k][j] = d->lu.data[best][j];
+				d->lu.data[best][j] = tmp;
+			}
+			unsigned tmp = d->pivot[k];
+			d->pivot[k] = d->pivot[best];
+			d->pivot[best] = tmp;
+			d->sign = -d->sign;
+		}
+
+		for (unsigned i = k + 1; i < n; i++) {
+			d->lu.data[i][k] /= d->lu.data[k][k];
+			for (unsigned j = k + 1; j < n; j++) {
+				d->lu.data[i][j] -= d->lu.data[i][k] * d->lu.data[k][j];
+			}
+		}
+	}
+
+	return 1;
+}
+
+static void solve(const struct Decomposition *d, const double *b, double *x) {
+	unsigned n = d->lu.rows;
+	for (unsigned i = 0; i < n; i++) {
+		double sum = b[d->pivot[i]];
+		for (unsigned j = 0; j < i; j++) {
+			sum -= d->lu.data[i][j] * x[j];
+		}
+		x[i] = sum;
+	}
+
+	for (unsigned i = n; i-- > 0;) {
+		double sum = x[i];
+		for (unsigned j = i + 1; j < n; j++) {
+			sum -= d->lu.data[i][j] * x[j];
+		}
+		x[i] = sum / d->lu.data[i][i];
+	}
+}
+
+static double determinant(const struct Decomposition *d) {
+	double det = d->sign;
+	for (unsigned i = 0; i < d->lu.rows; i++) {
+		det *= d->lu.data[i][i];
+	}
+	return det;
+}
+
+static double residual(const struct Matrix *m, const double *x, const double *b) {
+	double max = 0;
+	for (unsigned i = 0; i < m->rows; i++) {
+		double sum = -b[i];
+		for (unsigned j = 0; j < m->cols; j++) {
+			sum += m->data[i][j] * x[j];
+		}
+		if (fabs(sum) > max) {
+			max = fabs(sum);
+		}
+	}
+	return max;
+}
+
+int main(void) {
+	struct Matrix *a = malloc(sizeof(struct Matrix));
+	struct Matrix *b = malloc(sizeof(struct Matrix));
+	struct Matrix *product = malloc(sizeof(struct Matrix));
+	struct Decomposition *d = malloc(sizeof(struct Decomposition));
+	if (!a || !b || !product || !d) {
+		return 1;
+	}
+
+	int failures = 0;
+	for (unsigned size = 4; size <= N; size += 4) {
+		fill(a, size, size);
+		fill(b, size, size);
+		multiply(a, b, product);
+
+		if (!decompose(product, d)) {
+			failures++;
+			continue;
+		}
+
+		double rhs[N], x[N];
+		for (unsigned i = 0; i < size; i++) {
+			rhs[i] = nextRandom();
+		}
+		solve(d, rhs, x);
+
+		double error = residual(product, x, rhs);
+		printf("%2u: log|det| = %10.4f, residual %s\n", size, log(fabs(determinant(d))), error < 1e-9 ? "ok" : "too big");
+		if (error >= 1e-9) {
+			failures++;
+		}
+	}
+
+	free(a);
+	free(b);
+	free(product);
+	free(d);
+	return failures;
+}
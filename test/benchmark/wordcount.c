@@ -0,0 +1,184 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Counts words of a text in a chained hash table and prints the most frequent ones. */
+
+struct Entry {
+	char *word;
+	unsigned count;
+	unsigned firstPosition;
+	struct Entry *next;
+};
+
+struct Table {
+	struct Entry **buckets;
+	unsigned size;
+	unsigned count;
+};
+
+static const char *text =
+	"It was the best of times, it was the worst of times, it was the age of wisdom, "
+	"it was the age of foolishness, it was the epoch of belief, it was the epoch of "
+	"incredulity, it was the season of Light, it was the season of Darkness, it was "
+	"the spring of hope, it was the winter of despair, we had everything before us, "
+	"we had nothing before us, we were all going direct to Heaven, we were all going "
+	"direct the other way - in short, the period was so far like the present period, "
+	"that some of its noisiest authorities insisted on its being received, for good "
+	"or for evil, in the superlative degree of comparison only.";
+
+static unsigned hash(const char *word) {
+	unsigned h = 2166136261u;
+	while (*word) {
+		h ^= (unsigned char) *word++;
+		h *= 16777619u;
+	}
+	return h;
+}
+
+static int init(struct Table *table, unsigned size) {
+	table->buckets = calloc(size, sizeof(struct Entry *));
+	table->size = size;
+	table->count = 0;
+	return table->buckets != NULL;
+}
+
+static void destroy(struct Table *table) {
+	for (unsigned i = 0; i < table->size; i++) {
+		struct Entry *entry = table->buckets[i];
+		while (entry) {
+			struct Entry *next = entry->next;
+			free(entry->word);
+			free(entry);
+			entry = next;
+		}
+	}
+	free(table->buckets);
+}
+
+static int grow(struct Table *table) {
+	unsigned size = table->size * 2;
+	struct Entry **buckets = calloc(size, sizeof(struct Entry *));
+	if (!buckets) {
+		return 0;
+	}
+
+	for (unsigned i = 0; i < table->size; i++) {
+		struct Entry *entry = table->buckets[i];
+		while (entry) {
+			struct Entry *next = entry->next;
+			unsigned index = hash(entry->word) & (size - 1);
+			entry->next = buckets[index];
+			buckets[index] = entry;
+			entry = next;
+		}
+	}
+
+	free(table->buckets);
+	table->buckets = buckets;
+	table->size = size;
+	return 1;
+}
+
+static struct Entry *insert(struct Table *table, const char *word, unsigned position) {
+	unsigned index = hash(word) & (table->size - 1);
+	for (struct Entry *entry = table->buckets[index]; entry; entry = entry->next) {
+		if (strcmp(entry->word, word) == 0) {
+			entry->count++;
+			return entry;
+		}
+	}
+
+	if (table->count * 4 >= table->size * 3) {
+		if (!grow(table)) {
+			return NULL;
+		}
+		index = hash(word) & (table->size - 1);
+	}
+
+	struct Entry *entry = malloc(sizeof(struct Entry));
+	if (!entry) {
+		return NULL;
+	}
+
+	entry->word = malloc(strlen(word) + 1);
+	if (!entry->word) {
+		free(entry);
+		return NULL;
+	}
+	strcpy(entry->word, word);
+	entry->count = 1;
+	entry->firstPosition = position;
+	entry->next = table->buckets[index];
+	table->buckets[index] = entry;
+	table->count++;
+	return entry;
+}
+
+static int isLetter(char c) {
+	return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+static char toLower(char c) {
+	return c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c;
+}
+
+static int compare(const void *a, const void *b) {
+	const struct Entry *x = *(const struct Entry **) a;
+	const struct Entry *y = *(const struct Entry **) b;
+	if (x->count != y->count) {
+		return x->count > y->count ? -1 : 1;
+	}
+	return x->firstPosition < y->firstPosition ? -1 : x->firstPosition > y->firstPosition;
+}
+
+int main(void) {
+	struct Table table;
+	if (!init(&table, 8)) {
+		return 1;
+	}
+
+	char word[64];
+	unsigned length = 0;
+	unsigned position = 0;
+	for (const char *c = text;; c++) {
+		if (isLetter(*c) && length < sizeof(word) - 1) {
+			word[length++] = toLower(*c);
+		} else if (length > 0) {
+			word[length] = '\0';
+			if (!insert(&table, word, position++)) {
+				destroy(&table);
+				return 2;
+			}
+			length = 0;
+		}
+
+		if (*c == '\0') {
+			break;
+		}
+	}
+
+	struct Entry **entries = malloc(table.count * sizeof(struct Entry *));
+	if (!entries) {
+		destroy(&table);
+		return 3;
+	}
+
+	unsigned count = 0;
+	for (unsigned i = 0; i < table.size; i++) {
+		for (struct Entry *entry = table.buckets[i]; entry; entry = entry->next) {
+			entries[count++] = entry;
+		}
+	}
+	qsort(entries, count, sizeof(struct Entry *), compare);
+
+	unsigned checksum = 0;
+	for (unsigned i = 0; i < count && i < 10; i++) {
+		printf("%-12s %u\n", entries[i]->word, entries[i]->count);
+		checksum = checksum * 31 + entries[i]->count;
+	}
+
+	free(entries);
+	destroy(&table);
+	return (int) (checksum % 128);
+}
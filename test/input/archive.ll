@@ -0,0 +1,20 @@
+; only archive members defining undefined symbols are linked, like from a static library
+; ARCHIVE: lib/square.ll lib/cube.ll lib/conflict.ll
+; CHECK: cube(
+; CHECK: square(
+; CHECK-NOT: negate(
+
+@offset = global i32 7
+
+declare i32 @atoi(i8*)
+declare i32 @cube(i32)
+
+define i32 @main(i32 %argc, i8** %argv) {
+  %argPtr = getelementptr i8*, i8** %argv, i64 1
+  %str = load i8*, i8** %argPtr
+  %x = call i32 @atoi(i8* %str)
+  %cube = call i32 @cube(i32 %x)
+  %offset = load i32, i32* @offset
+  %result = add i32 %cube, %offset
+  ret i32 %result
+}
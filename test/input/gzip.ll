@@ -0,0 +1,18 @@
+; compressed IR with bytes following the gzip member is translated into a compressed file
+; GZIP: 512
+; CHECK: int twice(int var0) {
+
+declare i32 @atoi(i8*)
+
+define i32 @twice(i32 %x) {
+  %result = shl i32 %x, 1
+  ret i32 %result
+}
+
+define i32 @main(i32 %argc, i8** %argv) {
+  %argPtr = getelementptr i8*, i8** %argv, i64 1
+  %str = load i8*, i8** %argPtr
+  %x = call i32 @atoi(i8* %str)
+  %result = call i32 @twice(i32 %x)
+  ret i32 %result
+}
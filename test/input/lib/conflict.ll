@@ -0,0 +1,8 @@
+; archive member defining nothing the test needs, linking it would fail on the redefinition of @offset
+
+@offset = global i32 100
+
+define i32 @negate(i32 %x) {
+  %result = sub i32 0, %x
+  ret i32 %result
+}
@@ -0,0 +1,9 @@
+; archive member needing another member, which is linked only after this one
+
+declare i32 @square(i32)
+
+define i32 @cube(i32 %x) {
+  %square = call i32 @square(i32 %x)
+  %result = mul i32 %square, %x
+  ret i32 %result
+}
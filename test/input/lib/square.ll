@@ -0,0 +1,6 @@
+; helper of the input tests, linked with them or packed into an archive
+
+define i32 @square(i32 %x) {
+  %result = mul i32 %x, %x
+  ret i32 %result
+}
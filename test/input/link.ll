@@ -0,0 +1,14 @@
+; inputs are linked into one module, so the definition of @square is translated with the test
+; LINK: lib/square.ll
+; CHECK: int square(int var0) {
+
+declare i32 @atoi(i8*)
+declare i32 @square(i32)
+
+define i32 @main(i32 %argc, i8** %argv) {
+  %argPtr = getelementptr i8*, i8** %argv, i64 1
+  %str = load i8*, i8** %argPtr
+  %x = call i32 @atoi(i8* %str)
+  %result = call i32 @square(i32 %x)
+  ret i32 %result
+}
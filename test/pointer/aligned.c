@@ -0,0 +1,36 @@
+#include <stdlib.h>
+
+_Alignas(64) int table[16];
+
+int sum(int* p) {
+	int s = 0;
+	for (int i = 0; i < 16; i++) {
+		s += p[i];
+	}
+	return s;
+}
+
+int main(int argc, char** argv) {
+	if (argc != 2) {
+		return -1;
+	}
+
+	char *p;
+	long num = strtol(argv[1], &p, 10);
+
+	if (*p != '\0') {
+		return -1;
+	}
+
+	_Alignas(32) int local[16];
+	for (int i = 0; i < 16; i++) {
+		table[i] = num + i;
+		local[i] = i;
+	}
+
+	if ((unsigned long)table % 64 != 0 || (unsigned long)local % 32 != 0) {
+		return 1;
+	}
+
+	return sum(table) + sum(local) > 0;
+}
@@ -0,0 +1,34 @@
+; canonical prototypes are used only if widths of integers match the C types of the data layout
+; CHECK: int tolower(int);
+; CHECK: long long atoll(const char*);
+; CHECK: void* malloc(__SIZE_TYPE__);
+; declarations with integers of other widths keep the types from the module
+; CHECK-NOT: __SIZE_TYPE__ strlen(const char*);
+; CHECK-NOT: long atol(const char*);
+; main is optnone, so that the library calls are not simplified at any optimization level
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+
+@number = constant [6 x i8] c"12345\00"
+@format = constant [15 x i8] c"%d %lld %d %d\0A\00"
+
+declare i32 @printf(i8*, ...)
+declare i32 @tolower(i32)
+declare i64 @atoll(i8*)
+declare i8* @malloc(i64)
+declare void @free(i8*)
+declare i32 @strlen(i8*)
+declare i32 @atol(i8*)
+
+define i32 @main() noinline optnone {
+  %str = getelementptr [6 x i8], [6 x i8]* @number, i64 0, i64 0
+  %lower = call i32 @tolower(i32 65)
+  %long = call i64 @atoll(i8* %str)
+  %length = call i32 @strlen(i8* %str)
+  %short = call i32 @atol(i8* %str)
+  %memory = call i8* @malloc(i64 16)
+  call void @free(i8* %memory)
+  %formatPtr = getelementptr [15 x i8], [15 x i8]* @format, i64 0, i64 0
+  call i32 (i8*, ...) @printf(i8* %formatPtr, i32 %lower, i64 %long, i32 %length, i32 %short)
+  ret i32 0
+}
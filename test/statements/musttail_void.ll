@@ -0,0 +1,23 @@
+; musttail call of a void function is returned only when the compiler supports the attribute
+; CHECK: LLVM2C_MUSTTAIL_VOID(add(var0));
+
+@sum = global i32 0
+
+define void @add(i32 %x) noinline {
+  %old = load i32, i32* @sum
+  %new = add i32 %old, %x
+  store i32 %new, i32* @sum
+  ret void
+}
+
+define void @addTail(i32 %x) noinline {
+  musttail call void @add(i32 %x)
+  ret void
+}
+
+define i32 @main(i32 %argc, i8** %argv) {
+  call void @addTail(i32 3)
+  call void @addTail(i32 4)
+  %sum = load i32, i32* @sum
+  ret i32 %sum
+}
@@ -0,0 +1,97 @@
+; adjacent cases with the same successor are merged into GNU case ranges, which do not cross zero
+; CHECK: case (-9223372036854775807LL - 1) ... -9223372036854775807:
+; CHECK: case -2 ... -1:
+; CHECK: case 0 ... 2:
+; CHECK: case 10 ... 12:
+; cases 10 ... 12 and 20 share one goto
+; CHECK: case 20:
+; CHECK: case 4294967296 ... 4294967297:
+; CHECK: case 9223372036854775807:
+; cases jumping to the default block are dropped
+; CHECK-NOT: case 5:
+; functions are optnone, so that the switch is kept and no phi nodes are created at any optimization level
+
+@probes = constant [25 x i64] [i64 -9223372036854775808, i64 -9223372036854775807, i64 -9223372036854775806,
+                               i64 -3, i64 -2, i64 -1, i64 0, i64 2, i64 3, i64 5,
+                               i64 9, i64 10, i64 12, i64 13, i64 19, i64 20, i64 21,
+                               i64 4294967295, i64 4294967296, i64 4294967297, i64 4294967298,
+                               i64 9223372036854775806, i64 9223372036854775807, i64 7, i64 11]
+@expected = constant [25 x i32] [i32 1, i32 1, i32 0,
+                                 i32 0, i32 2, i32 2, i32 2, i32 2, i32 0, i32 0,
+                                 i32 0, i32 3, i32 3, i32 0, i32 0, i32 3, i32 0,
+                                 i32 0, i32 4, i32 4, i32 0,
+                                 i32 0, i32 5, i32 6, i32 3]
+
+declare i32 @atoi(i8*)
+
+define i32 @classify(i64 %x) noinline optnone {
+  switch i64 %x, label %default [
+    i64 -9223372036854775808, label %min
+    i64 -9223372036854775807, label %min
+    i64 -2, label %small
+    i64 -1, label %small
+    i64 0, label %small
+    i64 1, label %small
+    i64 2, label %small
+    i64 10, label %tens
+    i64 11, label %tens
+    i64 12, label %tens
+    i64 20, label %tens
+    i64 4294967297, label %big
+    i64 4294967296, label %big
+    i64 9223372036854775807, label %max
+    i64 5, label %default
+    i64 7, label %seven
+  ]
+min:
+  ret i32 1
+small:
+  ret i32 2
+tens:
+  ret i32 3
+big:
+  ret i32 4
+max:
+  ret i32 5
+seven:
+  ret i32 6
+default:
+  ret i32 0
+}
+
+; returns 100 + index of the first misclassified probe, otherwise classes of argv[1] and argv[1] + 10
+define i32 @main(i32 %argc, i8** %argv) noinline optnone {
+entry:
+  %counter = alloca i64
+  store i64 0, i64* %counter
+  br label %loop
+loop:
+  %i = load i64, i64* %counter
+  %probePtr = getelementptr [25 x i64], [25 x i64]* @probes, i64 0, i64 %i
+  %probe = load i64, i64* %probePtr
+  %expectedPtr = getelementptr [25 x i32], [25 x i32]* @expected, i64 0, i64 %i
+  %expectedClass = load i32, i32* %expectedPtr
+  %class = call i32 @classify(i64 %probe)
+  %correct = icmp eq i32 %class, %expectedClass
+  br i1 %correct, label %ok, label %wrong
+ok:
+  %next = add i64 %i, 1
+  store i64 %next, i64* %counter
+  %done = icmp eq i64 %next, 25
+  br i1 %done, label %arg, label %loop
+wrong:
+  %index = trunc i64 %i to i32
+  %code = add i32 %index, 100
+  ret i32 %code
+arg:
+  %argPtr = getelementptr i8*, i8** %argv, i64 1
+  %str = load i8*, i8** %argPtr
+  %num = call i32 @atoi(i8* %str)
+  %value = sext i32 %num to i64
+  %shifted = add i64 %value, 10
+  %first = call i32 @classify(i64 %value)
+  %second = call i32 @classify(i64 %shifted)
+  %tensDigit = mul i32 %first, 10
+  %result = add i32 %tensDigit, %second
+  ret i32 %result
+}
@@ -0,0 +1,45 @@
+; clang at -O0 does not build aggregates by insertvalue, so the chains are written by hand
+
+%struct.pair = type { i64, i64 }
+%struct.nested = type { i32, %struct.pair, [3 x i32] }
+
+declare i32 @atoi(i8*)
+
+define %struct.pair @makePair(i64 %first, i64 %second) noinline {
+  %1 = insertvalue %struct.pair undef, i64 %first, 0
+  %2 = insertvalue %struct.pair %1, i64 %second, 1
+  ret %struct.pair %2
+}
+
+define %struct.nested @makeNested(i32 %n) noinline {
+  %pair = call %struct.pair @makePair(i64 7, i64 -3)
+  %1 = insertvalue %struct.nested undef, i32 %n, 0
+  %2 = insertvalue %struct.nested %1, %struct.pair %pair, 1
+  %3 = insertvalue %struct.nested %2, i64 11, 1, 1
+  %4 = insertvalue %struct.nested %3, [3 x i32] zeroinitializer, 2
+  %5 = insertvalue %struct.nested %4, i32 %n, 2, 0
+  %6 = insertvalue %struct.nested %5, i32 5, 2, 2
+  ret %struct.nested %6
+}
+
+define i32 @main(i32 %argc, i8** %argv) {
+  %argp = getelementptr i8*, i8** %argv, i64 1
+  %arg = load i8*, i8** %argp
+  %n = call i32 @atoi(i8* %arg)
+  %nested = call %struct.nested @makeNested(i32 %n)
+  %a = extractvalue %struct.nested %nested, 0
+  %b = extractvalue %struct.nested %nested, 1, 0
+  %c = extractvalue %struct.nested %nested, 1, 1
+  %d = extractvalue %struct.nested %nested, 2, 0
+  %e = extractvalue %struct.nested %nested, 2, 1
+  %f = extractvalue %struct.nested %nested, 2, 2
+  %b32 = trunc i64 %b to i32
+  %c32 = trunc i64 %c to i32
+  %1 = mul i32 %a, 3
+  %2 = add i32 %1, %b32
+  %3 = mul i32 %c32, %d
+  %4 = add i32 %2, %3
+  %5 = add i32 %4, %e
+  %6 = add i32 %5, %f
+  ret i32 %6
+}
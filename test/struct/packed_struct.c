@@ -0,0 +1,40 @@
+#include <stdlib.h>
+
+struct __attribute__((packed)) header {
+	char type;
+	int length;
+	short checksum;
+};
+
+struct message {
+	char flag;
+	struct header h;
+	int payload;
+};
+
+int main(int argc, char** argv) {
+	if (argc != 2) {
+		return -1;
+	}
+
+	char *p;
+	long num = strtol(argv[1], &p, 10);
+
+	if (*p != '\0') {
+		return -1;
+	}
+
+	struct message messages[3];
+	for (int i = 0; i < 3; i++) {
+		messages[i].flag = i;
+		messages[i].h.type = num;
+		messages[i].h.length = num * i;
+		messages[i].h.checksum = num + i;
+		messages[i].payload = i;
+	}
+
+	char *raw = (char *) &messages[2];
+	int length = *(int *) (raw + 2);
+
+	return sizeof(struct header) + sizeof(struct message) + length + messages[1].h.checksum;
+}
@@ -0,0 +1,31 @@
+#include <stdlib.h>
+
+struct data {
+	int id;
+	long values[8];
+	double weight;
+};
+
+int main(int argc, char** argv) {
+	if (argc != 2) {
+		return -1;
+	}
+
+	char *p;
+	long num = strtol(argv[1], &p, 10);
+
+	if (*p != '\0') {
+		return -1;
+	}
+
+	struct data first = {0};
+	first.id = num;
+	for (int i = 0; i < 8; i++) {
+		first.values[i] = num * i;
+	}
+
+	struct data second = first;
+	second.values[3] += 2;
+
+	return second.id + second.values[3] + first.values[7];
+}
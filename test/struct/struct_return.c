@@ -0,0 +1,34 @@
+#include <stdlib.h>
+
+struct pair {
+	long first;
+	long second;
+};
+
+struct pair make_pair(long first, long second) {
+	struct pair p = {first, second};
+	return p;
+}
+
+struct pair swap(struct pair p) {
+	struct pair ret = {p.second, p.first};
+	return ret;
+}
+
+int main(int argc, char** argv) {
+	if (argc != 2) {
+		return -1;
+	}
+
+	char *p;
+	long num = strtol(argv[1], &p, 10);
+
+	if (*p != '\0') {
+		return -1;
+	}
+
+	struct pair pair = swap(make_pair(num, num * 2));
+	struct pair copy = pair;
+
+	return copy.first - copy.second;
+}
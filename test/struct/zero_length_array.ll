@@ -0,0 +1,16 @@
+; zero-length arrays have no element which could be initialized by {0}
+; CHECK-NOT: empty[0] =
+; CHECK: {5, {}}
+
+%struct.tail = type { i32, [0 x i32] }
+
+@empty = global [0 x i32] zeroinitializer
+@tail = global %struct.tail { i32 5, [0 x i32] zeroinitializer }
+@tails = global [2 x %struct.tail] zeroinitializer
+
+define i32 @main(i32 %argc, i8** %argv) {
+  %a = load i32, i32* getelementptr (%struct.tail, %struct.tail* @tail, i32 0, i32 0)
+  %b = load i32, i32* getelementptr ([2 x %struct.tail], [2 x %struct.tail]* @tails, i32 0, i32 1, i32 0)
+  %sum = add i32 %a, %b
+  ret i32 %sum
+}
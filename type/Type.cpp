@@ -3,12 +3,34 @@
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include "../core/MemoryReport.h"
+
+#include <cstdlib>
+#include <new>
+
+void* Type::operator new(std::size_t size) {
+    void* ptr = std::malloc(size);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+
+    MemoryReport::allocated(MemoryReport::TYPE, size);
+    return ptr;
+}
+
+void Type::operator delete(void* ptr, std::size_t size) {
+    MemoryReport::deallocated(MemoryReport::TYPE, size);
+    std::free(ptr);
+}
+
 FunctionPointerType::FunctionPointerType(const std::string& type, const std::string& name, const std::string& typeEnd)
-    : type(type),
+    : Type(TK_FunctionPointer),
+      type(type),
       name(name),
       typeEnd(typeEnd) { }
 
-FunctionPointerType::FunctionPointerType(const FunctionPointerType& other) {
+FunctionPointerType::FunctionPointerType(const FunctionPointerType& other)
+    : Type(TK_FunctionPointer) {
     type = other.type;
     name = other.name;
     typeEnd = other.typeEnd;
@@ -35,9 +57,11 @@ std::string FunctionPointerType::defToString() const {
 }
 
 StructType::StructType(const std::string& name)
-    : name(name) { }
+    : Type(TK_Struct),
+      name(name) { }
 
-StructType::StructType(const StructType& other) {
+StructType::StructType(const StructType& other)
+    : Type(TK_Struct) {
     name = other.name;
 }
 
@@ -56,12 +80,13 @@ std::string StructType::toString() const {
 }
 
 ArrayType::ArrayType(std::unique_ptr<Type> type, unsigned int size)
-    : type(std::move(type)),
+    : Type(TK_Array),
+      type(std::move(type)),
       size(size) {
     isStructArray = false;
     isPointerArray = false;
 
-    if (auto AT = dynamic_cast<ArrayType*>(this->type.get())) {
+    if (auto AT = llvm::dyn_cast<ArrayType>(this->type.get())) {
         isStructArray = AT->isStructArray;
         structName = AT->structName;
 
@@ -69,18 +94,19 @@ ArrayType::ArrayType(std::unique_ptr<Type> type, unsigned int size)
         pointer = AT->pointer;
     }
 
-    if (auto ST = dynamic_cast<StructType*>(this->type.get())) {
+    if (auto ST = llvm::dyn_cast<StructType>(this->type.get())) {
         isStructArray = true;
         structName = ST->name;
     }
 
-    if (auto PT = dynamic_cast<PointerType*>(this->type.get())) {
+    if (auto PT = llvm::dyn_cast<PointerType>(this->type.get())) {
         isPointerArray = true;
         pointer = PT;
     }
 }
 
-ArrayType::ArrayType(const ArrayType& other) {
+ArrayType::ArrayType(const ArrayType& other)
+    : Type(TK_Array) {
     size = other.size;
     type = other.type->clone();
     isStructArray = other.isStructArray;
@@ -113,13 +139,16 @@ std::string ArrayType::sizeToString() const {
     ret += "[";
     ret += std::to_string(size);
     ret += "]";
-    if (ArrayType* AT = dynamic_cast<ArrayType*>(type.get())) {
+    if (ArrayType* AT = llvm::dyn_cast<ArrayType>(type.get())) {
         ret += AT->sizeToString();
     }
 
     return ret;
 }
 
+VoidType::VoidType()
+    : Type(TK_Void) { }
+
 std::unique_ptr<Type> VoidType::clone() const  {
     return std::make_unique<VoidType>();
 }
@@ -132,12 +161,13 @@ std::string VoidType::toString() const {
     return "void";
 }
 
-PointerType::PointerType(std::unique_ptr<Type> type) {
+PointerType::PointerType(std::unique_ptr<Type> type)
+    : Type(TK_Pointer) {
     levels = 1;
     isArrayPointer = false;
     isStructPointer = false;
 
-    if (auto PT = dynamic_cast<PointerType*>(type.get())) {
+    if (auto PT = llvm::dyn_cast<PointerType>(type.get())) {
         isArrayPointer = PT->isArrayPointer;
         isStructPointer = PT->isStructPointer;
         structName = PT->structName;
@@ -145,7 +175,7 @@ PointerType::PointerType(std::unique_ptr<Type> type) {
         sizes = PT->sizes;
     }
 
-    if (auto AT = dynamic_cast<ArrayType*>(type.get())) {
+    if (auto AT = llvm::dyn_cast<ArrayType>(type.get())) {
         isArrayPointer = true;
         sizes = AT->sizeToString();
 
@@ -153,7 +183,7 @@ PointerType::PointerType(std::unique_ptr<Type> type) {
         structName = AT->structName;
     }
 
-    if (auto ST = dynamic_cast<StructType*>(type.get())) {
+    if (auto ST = llvm::dyn_cast<StructType>(type.get())) {
         isStructPointer = true;
         structName = ST->name;
     }
@@ -161,7 +191,8 @@ PointerType::PointerType(std::unique_ptr<Type> type) {
     this->type = type->clone();
 }
 
-PointerType::PointerType(const PointerType &other) {
+PointerType::PointerType(const PointerType &other)
+    : Type(TK_Pointer) {
     type = other.type->clone();
     isArrayPointer = other.isArrayPointer;
     levels = other.levels;
@@ -187,10 +218,17 @@ std::string PointerType::toString() const {
 }
 
 IntegerType::IntegerType(const std::string& name, bool unsignedType)
-    : name(name),
+    : Type(TK_Integer),
+      name(name),
       unsignedType(unsignedType) { }
 
-IntegerType::IntegerType(const IntegerType& other) {
+IntegerType::IntegerType(TypeKind kind, const std::string& name, bool unsignedType)
+    : Type(kind),
+      name(name),
+      unsignedType(unsignedType) { }
+
+IntegerType::IntegerType(const IntegerType& other)
+    : Type(other.getKind()) {
     name = other.name;
     unsignedType = other.unsignedType;
 }
@@ -215,44 +253,50 @@ std::string IntegerType::toString() const {
 }
 
 CharType::CharType(bool unsignedType)
-    : IntegerType("char", unsignedType) { }
+    : IntegerType(TK_Char, "char", unsignedType) { }
 
 std::unique_ptr<Type> CharType::clone() const  {
     return std::make_unique<CharType>(*this);
 }
 
 IntType::IntType(bool unsignedType)
-    : IntegerType("int", unsignedType) { }
+    : IntegerType(TK_Int, "int", unsignedType) { }
 
 std::unique_ptr<Type> IntType::clone() const  {
     return std::make_unique<IntType>(*this);
 }
 
 ShortType::ShortType(bool unsignedType)
-    : IntegerType("short", unsignedType) { }
+    : IntegerType(TK_Short, "short", unsignedType) { }
 
 std::unique_ptr<Type> ShortType::clone() const  {
     return std::make_unique<ShortType>(*this);
 }
 
 LongType::LongType(bool unsignedType)
-    : IntegerType("long", unsignedType) { }
+    : IntegerType(TK_Long, "long", unsignedType) { }
 
 std::unique_ptr<Type> LongType::clone() const  {
     return std::make_unique<LongType>(*this);
 }
 
 Int128::Int128()
-    : IntegerType("__int128", false) { }
+    : IntegerType(TK_Int128, "__int128", false) { }
 
 std::unique_ptr<Type> Int128::clone() const {
     return std::make_unique<Int128>();
 }
 
 FloatingPointType::FloatingPointType(const std::string& name)
-    :name(name) { }
+    : Type(TK_FloatingPoint),
+      name(name) { }
+
+FloatingPointType::FloatingPointType(TypeKind kind, const std::string& name)
+    : Type(kind),
+      name(name) { }
 
-FloatingPointType::FloatingPointType(const FloatingPointType& other) {
+FloatingPointType::FloatingPointType(const FloatingPointType& other)
+    : Type(other.getKind()) {
     name = other.name;
 }
 
@@ -271,21 +315,21 @@ std::string FloatingPointType::toString() const {
 }
 
 FloatType::FloatType()
-    : FloatingPointType("float") { }
+    : FloatingPointType(TK_Float, "float") { }
 
 std::unique_ptr<Type> FloatType::clone() const  {
     return std::make_unique<FloatType>(*this);
 }
 
 DoubleType::DoubleType()
-    : FloatingPointType("double") { }
+    : FloatingPointType(TK_Double, "double") { }
 
 std::unique_ptr<Type> DoubleType::clone() const  {
     return std::make_unique<DoubleType>(*this);
 }
 
 LongDoubleType::LongDoubleType()
-    : FloatingPointType("long double") { }
+    : FloatingPointType(TK_LongDouble, "long double") { }
 
 std::unique_ptr<Type> LongDoubleType::clone() const  {
     return std::make_unique<LongDoubleType>(*this);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "llvm/IR/Type.h"
+#include "llvm/Support/Casting.h"
 
 #include <string>
 #include <memory>
@@ -10,6 +11,37 @@
  */
 class Type {
 public:
+    /**
+     * @brief The TypeKind enum identifies the class of the type, it is used by llvm::isa and llvm::dyn_cast.
+     * Kinds of subclasses of IntegerType and FloatingPointType have to be kept in contiguous ranges.
+     */
+    enum TypeKind {
+        TK_FunctionPointer,
+        TK_Struct,
+        TK_Pointer,
+        TK_Array,
+        TK_Void,
+        TK_Integer,
+        TK_Char,
+        TK_Short,
+        TK_Int,
+        TK_Long,
+        TK_Int128,
+        TK_LastInteger = TK_Int128,
+        TK_FloatingPoint,
+        TK_Float,
+        TK_Double,
+        TK_LongDouble,
+        TK_LastFloatingPoint = TK_LongDouble
+    };
+
+private:
+    const TypeKind kind;
+
+public:
+    Type(TypeKind kind)
+        : kind(kind) { }
+
     virtual ~Type() = default;
     virtual std::unique_ptr<Type> clone() const = 0;
     virtual void print() const = 0;
@@ -30,6 +62,24 @@ public:
 
         return ret;
     }
+
+    TypeKind getKind() const {
+        return kind;
+    }
+
+    /**
+     * @brief operator new Allocates the type, the allocation is counted in the memory report.
+     * @param size Size of the type
+     * @return Pointer to the allocated memory
+     */
+    static void* operator new(std::size_t size);
+
+    /**
+     * @brief operator delete Deallocates the type, the deallocation is counted in the memory report.
+     * @param ptr Pointer to the type
+     * @param size Size of the type
+     */
+    static void operator delete(void* ptr, std::size_t size);
 };
 
 /**
@@ -57,6 +107,10 @@ public:
      * @return String with FunctionPointerType definition
      */
     std::string defToString() const;
+
+    static bool classof(const Type* type) {
+        return type->getKind() == TK_FunctionPointer;
+    }
 };
 
 /**
@@ -72,6 +126,10 @@ public:
     std::unique_ptr<Type> clone() const override;
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Type* type) {
+        return type->getKind() == TK_Struct;
+    }
 };
 
 /**
@@ -94,6 +152,10 @@ public:
     std::unique_ptr<Type> clone() const override;
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Type* type) {
+        return type->getKind() == TK_Pointer;
+    }
 };
 
 /**
@@ -119,6 +181,10 @@ public:
 
     void printSize() const;
     std::string sizeToString() const;
+
+    static bool classof(const Type* type) {
+        return type->getKind() == TK_Array;
+    }
 };
 
 /**
@@ -126,9 +192,15 @@ public:
  */
 class VoidType : public Type {
 public:
+    VoidType();
+
     std::unique_ptr<Type> clone() const override;
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Type* type) {
+        return type->getKind() == TK_Void;
+    }
 };
 
 /**
@@ -138,6 +210,9 @@ class IntegerType : public Type {
 private:
     std::string name;
 
+protected:
+    IntegerType(TypeKind, const std::string&, bool);
+
 public:
     bool unsignedType;
 
@@ -147,6 +222,10 @@ public:
     std::unique_ptr<Type> clone() const override;
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Type* type) {
+        return type->getKind() >= TK_Integer && type->getKind() <= TK_LastInteger;
+    }
 };
 
 /**
@@ -157,6 +236,10 @@ public:
     CharType(bool);
 
     std::unique_ptr<Type> clone() const override;
+
+    static bool classof(const Type* type) {
+        return type->getKind() == TK_Char;
+    }
 };
 
 /**
@@ -167,6 +250,10 @@ public:
     IntType(bool);
 
     std::unique_ptr<Type> clone() const override;
+
+    static bool classof(const Type* type) {
+        return type->getKind() == TK_Int;
+    }
 };
 
 /**
@@ -177,6 +264,10 @@ public:
     ShortType(bool);
 
     std::unique_ptr<Type> clone() const override;
+
+    static bool classof(const Type* type) {
+        return type->getKind() == TK_Short;
+    }
 };
 
 /**
@@ -187,6 +278,10 @@ public:
     LongType(bool);
 
     std::unique_ptr<Type> clone() const override;
+
+    static bool classof(const Type* type) {
+        return type->getKind() == TK_Long;
+    }
 };
 
 /**
@@ -197,6 +292,10 @@ public:
     Int128();
 
     std::unique_ptr<Type> clone() const override;
+
+    static bool classof(const Type* type) {
+        return type->getKind() == TK_Int128;
+    }
 };
 
 /**
@@ -206,6 +305,9 @@ class FloatingPointType : public Type {
 private:
     std::string name;
 
+protected:
+    FloatingPointType(TypeKind, const std::string&);
+
 public:
     FloatingPointType(const std::string&);
     FloatingPointType(const FloatingPointType&);
@@ -213,6 +315,10 @@ public:
     std::unique_ptr<Type> clone() const override;
     void print() const override;
     std::string toString() const override;
+
+    static bool classof(const Type* type) {
+        return type->getKind() >= TK_FloatingPoint && type->getKind() <= TK_LastFloatingPoint;
+    }
 };
 
 /**
@@ -223,6 +329,10 @@ public:
     FloatType();
 
     std::unique_ptr<Type> clone() const override;
+
+    static bool classof(const Type* type) {
+        return type->getKind() == TK_Float;
+    }
 };
 
 /**
@@ -233,6 +343,10 @@ public:
     DoubleType();
 
     std::unique_ptr<Type> clone() const override;
+
+    static bool classof(const Type* type) {
+        return type->getKind() == TK_Double;
+    }
 };
 
 /**
@@ -243,4 +357,8 @@ public:
     LongDoubleType();
 
     std::unique_ptr<Type> clone() const override;
+
+    static bool classof(const Type* type) {
+        return type->getKind() == TK_LongDouble;
+    }
 };
@@ -3,10 +3,13 @@
 #include "llvm/IR/DerivedTypes.h"
 
 #include "../core/Program.h"
+#include "../core/MemoryReport.h"
 
 #include <boost/lambda/lambda.hpp>
 
 std::unique_ptr<Type> TypeHandler::getType(const llvm::Type* type) {
+    MemoryReport::Scope memoryScope(MemoryReport::TYPE_HANDLER);
+
     if (typeDefs.find(type) != typeDefs.end()) {
         return typeDefs[type]->clone();
     }
@@ -70,7 +73,7 @@ std::unique_ptr<Type> TypeHandler::getType(const llvm::Type* type) {
                     auto paramType = getType(FT->getParamType(i));
                     param = paramType->toString();
 
-                    if (auto PT = dynamic_cast<PointerType*>(paramType.get())) {
+                    if (auto PT = llvm::dyn_cast<PointerType>(paramType.get())) {
                         if (PT->isArrayPointer) {
                             param += " (";
                             for (unsigned i = 0; i < PT->levels; i++) {
@@ -80,7 +83,7 @@ std::unique_ptr<Type> TypeHandler::getType(const llvm::Type* type) {
                         }
                     }
 
-                    if (auto AT = dynamic_cast<ArrayType*>(paramType.get())) {
+                    if (auto AT = llvm::dyn_cast<ArrayType>(paramType.get())) {
                         param += AT->sizeToString();
                     }
 
@@ -130,64 +133,58 @@ std::unique_ptr<Type> TypeHandler::getType(const llvm::Type* type) {
     return nullptr;
 }
 
+//conversion rank of types indexed by Type::TypeKind, types with rank 0 do not take part in arithmetic conversions
+static const unsigned CONVERSION_RANKS[] = {
+    0, //TK_FunctionPointer
+    0, //TK_Struct
+    0, //TK_Pointer
+    0, //TK_Array
+    0, //TK_Void
+    0, //TK_Integer
+    1, //TK_Char
+    2, //TK_Short
+    3, //TK_Int
+    4, //TK_Long
+    5, //TK_Int128
+    0, //TK_FloatingPoint
+    6, //TK_Float
+    7, //TK_Double
+    8, //TK_LongDouble
+};
+
+static_assert(sizeof(CONVERSION_RANKS) / sizeof(CONVERSION_RANKS[0]) == Type::TK_LastFloatingPoint + 1, "Every type kind has to have conversion rank");
+
 std::unique_ptr<Type> TypeHandler::getBinaryType(const Type* left, const Type* right) {
-    if (const auto LDT = dynamic_cast<const LongDoubleType*>(left)) {
-        return std::make_unique<LongDoubleType>();
-    }
-    if (const auto LDT = dynamic_cast<const LongDoubleType*>(right)) {
-        return std::make_unique<LongDoubleType>();
-    }
+    unsigned leftRank = left ? CONVERSION_RANKS[left->getKind()] : 0;
+    unsigned rightRank = right ? CONVERSION_RANKS[right->getKind()] : 0;
 
-    if (const auto DT = dynamic_cast<const DoubleType*>(left)) {
-        return std::make_unique<DoubleType>();
-    }
-    if (const auto DT = dynamic_cast<const DoubleType*>(right)) {
-        return std::make_unique<DoubleType>();
+    if (leftRank == 0 && rightRank == 0) {
+        return nullptr;
     }
 
-    if (const auto FT = dynamic_cast<const FloatType*>(left)) {
-        return std::make_unique<FloatType>();
-    }
-    if (const auto FT = dynamic_cast<const FloatType*>(right)) {
-        return std::make_unique<FloatType>();
-    }
+    //left operand is preferred if both operands have the same rank
+    const Type* type = leftRank >= rightRank ? left : right;
 
-    if (const auto UI = dynamic_cast<const Int128*>(left)) {
-        return std::make_unique<Int128>();
-    }
-    if (const auto UI = dynamic_cast<const Int128*>(right)) {
+    switch (type->getKind()) {
+    case Type::TK_LongDouble:
+        return std::make_unique<LongDoubleType>();
+    case Type::TK_Double:
+        return std::make_unique<DoubleType>();
+    case Type::TK_Float:
+        return std::make_unique<FloatType>();
+    case Type::TK_Int128:
         return std::make_unique<Int128>();
+    case Type::TK_Long:
+        return std::make_unique<LongType>(llvm::cast<IntegerType>(type)->unsignedType);
+    case Type::TK_Int:
+        return std::make_unique<IntType>(llvm::cast<IntegerType>(type)->unsignedType);
+    case Type::TK_Short:
+        return std::make_unique<ShortType>(llvm::cast<IntegerType>(type)->unsignedType);
+    case Type::TK_Char:
+        return std::make_unique<CharType>(llvm::cast<IntegerType>(type)->unsignedType);
+    default:
+        return nullptr;
     }
-
-    if (const auto LT = dynamic_cast<const LongType*>(left)) {
-        return std::make_unique<LongType>(LT->unsignedType);
-    }
-    if (const auto LT = dynamic_cast<const LongType*>(right)) {
-        return std::make_unique<LongType>(LT->unsignedType);
-    }
-
-    if (const auto IT = dynamic_cast<const IntType*>(left)) {
-        return std::make_unique<IntType>(IT->unsignedType);
-    }
-    if (const auto IT = dynamic_cast<const IntType*>(right)) {
-        return std::make_unique<IntType>(IT->unsignedType);
-    }
-
-    if (const auto ST = dynamic_cast<const ShortType*>(left)) {
-        return std::make_unique<ShortType>(ST->unsignedType);
-    }
-    if (const auto ST = dynamic_cast<const ShortType*>(right)) {
-        return std::make_unique<ShortType>(ST->unsignedType);
-    }
-
-    if (const auto CT = dynamic_cast<const CharType*>(left)) {
-        return std::make_unique<CharType>(CT->unsignedType);
-    }
-    if (const auto CT = dynamic_cast<const CharType*>(right)) {
-        return std::make_unique<CharType>(CT->unsignedType);
-    }
-
-    return nullptr;
 }
 
 std::string TypeHandler::getStructName(const std::string& structName) {